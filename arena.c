@@ -0,0 +1,131 @@
+/* See LICENSE file for license and copyright information */
+
+#include <string.h>
+#include <glib.h>
+
+#include "internal.h"
+
+#define ARENA_CHUNK_SIZE (16 * 1024)
+
+/**
+ * Alignment of all allocations handed out by the arena
+ */
+typedef union arena_align_u {
+  void* p;
+  long long l;
+  long double d;
+  void (*f)(void);
+} arena_align_t;
+
+typedef struct arena_chunk_s {
+  struct arena_chunk_s* next; /**< Previously filled chunk */
+  size_t size; /**< Usable size of the chunk */
+  size_t used; /**< Number of bytes handed out */
+  arena_align_t data[]; /**< Memory of the chunk */
+} arena_chunk_t;
+
+struct girara_arena_s {
+  arena_chunk_t* chunks; /**< Chunk that is currently filled, followed by the older ones */
+  size_t reserved; /**< Total number of bytes reserved */
+};
+
+static arena_chunk_t*
+arena_chunk_new(girara_arena_t* arena, size_t size)
+{
+  arena_chunk_t* chunk = g_malloc(sizeof(arena_chunk_t) + size);
+  chunk->size = size;
+  chunk->used = 0;
+
+  arena->reserved += size;
+  return chunk;
+}
+
+girara_arena_t*
+girara_arena_new(void)
+{
+  girara_arena_t* arena = g_slice_new(girara_arena_t);
+  arena->chunks   = NULL;
+  arena->reserved = 0;
+
+  return arena;
+}
+
+void
+girara_arena_free(girara_arena_t* arena)
+{
+  if (arena == NULL) {
+    return;
+  }
+
+  arena_chunk_t* chunk = arena->chunks;
+  while (chunk != NULL) {
+    arena_chunk_t* next = chunk->next;
+    g_free(chunk);
+    chunk = next;
+  }
+
+  g_slice_free(girara_arena_t, arena);
+}
+
+void*
+girara_arena_alloc(girara_arena_t* arena, size_t size)
+{
+  g_return_val_if_fail(arena != NULL, NULL);
+
+  size = (size + sizeof(arena_align_t) - 1) / sizeof(arena_align_t) *
+    sizeof(arena_align_t);
+
+  arena_chunk_t* chunk = arena->chunks;
+  if (chunk == NULL || chunk->size - chunk->used < size) {
+    if (size > ARENA_CHUNK_SIZE / 4) {
+      /* large objects get a chunk of their own behind the current one so that
+       * the free space of the current chunk is not wasted */
+      arena_chunk_t* large = arena_chunk_new(arena, size);
+      large->used = size;
+      if (chunk != NULL) {
+        large->next = chunk->next;
+        chunk->next = large;
+      } else {
+        large->next   = NULL;
+        arena->chunks = large;
+      }
+
+      memset(large->data, 0, size);
+      return large->data;
+    }
+
+    chunk         = arena_chunk_new(arena, ARENA_CHUNK_SIZE);
+    chunk->next   = arena->chunks;
+    arena->chunks = chunk;
+  }
+
+  void* memory = (char*) chunk->data + chunk->used;
+  chunk->used += size;
+
+  memset(memory, 0, size);
+  return memory;
+}
+
+char*
+girara_arena_strdup(girara_arena_t* arena, const char* str)
+{
+  if (str == NULL) {
+    return NULL;
+  }
+
+  const size_t size = strlen(str) + 1;
+  char* copy = girara_arena_alloc(arena, size);
+  if (copy != NULL) {
+    memcpy(copy, str, size);
+  }
+
+  return copy;
+}
+
+size_t
+girara_arena_get_size(girara_arena_t* arena)
+{
+  g_return_val_if_fail(arena != NULL, 0);
+
+  return arena->reserved;
+}
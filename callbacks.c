@@ -5,6 +5,7 @@
 #include "session.h"
 #include "shortcuts.h"
 #include "input-history.h"
+#include "settings.h"
 #include <string.h>
 #include <glib/gi18n-lib.h>
 
@@ -14,79 +15,168 @@ static const guint ALL_ACCELS_MASK = GDK_CONTROL_MASK | GDK_SHIFT_MASK | GDK_MOD
 static const guint MOUSE_MASK = GDK_CONTROL_MASK | GDK_SHIFT_MASK | GDK_MOD1_MASK |
   GDK_BUTTON1_MASK | GDK_BUTTON2_MASK | GDK_BUTTON3_MASK | GDK_BUTTON4_MASK | GDK_BUTTON5_MASK;
 
-static bool
-clean_mask(guint hardware_keycode, GdkModifierType state, gint group, guint* clean, guint* keyval)
+/* velocity lost per millisecond of kinetic scrolling */
+static const double KINETIC_FRICTION = 0.004;
+/* kinetic scrolling stops below this velocity (scroll units per millisecond) */
+static const double KINETIC_MIN_VELOCITY = 0.001;
+/* smooth scroll events further apart do not contribute to the velocity */
+static const guint32 KINETIC_MAX_INTERVAL = 100;
+
+static guint
+normalize_keyval(guint keyval)
 {
-  GdkModifierType consumed = 0;
-  if ((gdk_keymap_translate_keyboard_state(
-        gdk_keymap_get_default(),
-        hardware_keycode,
-        state, group,
-        keyval,
-        NULL,
-        NULL,
-        &consumed)
-      ) == FALSE) {
-    return false;
+  /* numpad numbers */
+  if (keyval >= GDK_KEY_KP_0 && keyval <= GDK_KEY_KP_9) {
+    return GDK_KEY_0 + (keyval - GDK_KEY_KP_0);
   }
 
-  if (clean != NULL) {
-    *clean = state & ~consumed & ALL_ACCELS_MASK;
+  return keyval;
+}
+
+static bool
+clean_mask(girara_session_t* session, guint hardware_keycode,
+    GdkModifierType state, gint group, guint* clean, guint* keyval)
+{
+  /* key repeats and replayed keys hit the same entry over and over again */
+  const guint slot = (hardware_keycode ^ (state * 31) ^ ((guint) group << 5))
+    % GIRARA_KEY_TRANSLATION_CACHE_SIZE;
+  girara_key_translation_t* translation =
+    &session->private_data->key_translations[slot];
+
+  if (translation->valid == false
+      || translation->hardware_keycode != hardware_keycode
+      || translation->state != state
+      || translation->group != group) {
+    GdkModifierType consumed = 0;
+    guint translated         = 0;
+    if ((gdk_keymap_translate_keyboard_state(
+          gdk_keymap_get_default(),
+          hardware_keycode,
+          state, group,
+          &translated,
+          NULL,
+          NULL,
+          &consumed)
+        ) == FALSE) {
+      return false;
+    }
+
+    translation->valid            = true;
+    translation->hardware_keycode = hardware_keycode;
+    translation->state            = state;
+    translation->group            = group;
+    translation->keyval           = normalize_keyval(translated);
+    translation->clean            = state & ~consumed & ALL_ACCELS_MASK;
   }
 
-  /* numpad numbers */
-  switch (*keyval) {
-    case GDK_KEY_KP_0:
-      *keyval = GDK_KEY_0;
-      break;
-    case GDK_KEY_KP_1:
-      *keyval = GDK_KEY_1;
-      break;
-    case GDK_KEY_KP_2:
-      *keyval = GDK_KEY_2;
-      break;
-    case GDK_KEY_KP_3:
-      *keyval = GDK_KEY_3;
-      break;
-    case GDK_KEY_KP_4:
-      *keyval = GDK_KEY_4;
-      break;
-    case GDK_KEY_KP_5:
-      *keyval = GDK_KEY_5;
-      break;
-    case GDK_KEY_KP_6:
-      *keyval = GDK_KEY_6;
-      break;
-    case GDK_KEY_KP_7:
-      *keyval = GDK_KEY_7;
-      break;
-    case GDK_KEY_KP_8:
-      *keyval = GDK_KEY_8;
-      break;
-    case GDK_KEY_KP_9:
-      *keyval = GDK_KEY_9;
-      break;
+  if (clean != NULL) {
+    *clean = translation->clean;
   }
+  *keyval = translation->keyval;
 
   return true;
 }
 
 /* callback implementation */
+static void
+shortcut_execute(girara_session_t* session, girara_shortcut_t* shortcut)
+{
+  if (shortcut->latency == NULL) {
+    char* name = girara_latency_shortcut_name(shortcut->mask, shortcut->key,
+        shortcut->buffered_command);
+    shortcut->latency = girara_latency_get(session, name);
+    g_free(name);
+  }
+
+  girara_latency_t* latency = shortcut->latency;
+  const gint64 start        = g_get_monotonic_time();
+
+  girara_profile_entry_t* profile = girara_profile_shortcut(session, shortcut->function);
+  const gint64 cpu_start          = girara_profile_begin();
+
+  /* lets feedkeys keep the parsed argument with the shortcut */
+  girara_shortcut_t* running = session->private_data->feedkeys.shortcut;
+  session->private_data->feedkeys.shortcut = shortcut;
+
+  if (shortcut->count_aware == true) {
+    shortcut->function(session, &(shortcut->argument), NULL, session->buffer.n);
+  } else {
+    int t = (session->buffer.n > 0) ? session->buffer.n : 1;
+    for (int i = 0; i < t; i++) {
+      if (shortcut->function(session, &(shortcut->argument), NULL, session->buffer.n) == false) {
+        break;
+      }
+    }
+  }
+
+  session->private_data->feedkeys.shortcut = running;
+
+  girara_profile_end(profile, cpu_start);
+
+  girara_latency_record(session, GIRARA_LATENCY_KEY_PRESS, latency,
+      session->private_data->latency.event_time, start);
+}
+
+static void
+mouse_event_run(girara_session_t* session, girara_mouse_event_t* mouse_event,
+    girara_event_t* event, unsigned int t, guint32 event_time)
+{
+  if (mouse_event->latency == NULL) {
+    char* name = girara_latency_mouse_event_name(mouse_event->mask,
+        mouse_event->button, mouse_event->event_type);
+    mouse_event->latency = girara_latency_get(session, name);
+    g_free(name);
+  }
+
+  girara_latency_t* latency = mouse_event->latency;
+  const gint64 start        = g_get_monotonic_time();
+
+  girara_profile_entry_t* profile = girara_profile_shortcut(session, mouse_event->function);
+  const gint64 cpu_start          = girara_profile_begin();
+
+  mouse_event->function(session, &(mouse_event->argument), event, t);
+
+  girara_profile_end(profile, cpu_start);
+
+  girara_latency_record(session, girara_latency_mouse_source(event->type),
+      latency, event_time, start);
+}
+
 bool
 girara_callback_view_key_press_event(GtkWidget* UNUSED(widget),
     GdkEventKey* event, girara_session_t* session)
 {
   g_return_val_if_fail(session != NULL, FALSE);
 
+  /* keys passed on by feedkeys have been dispatched already */
+  if (session->private_data->feedkeys.passthrough != 0 &&
+      event->time == GDK_CURRENT_TIME) {
+    session->private_data->feedkeys.passthrough--;
+    return false;
+  }
+
   guint clean  = 0;
   guint keyval = 0;
 
-  if (clean_mask(event->hardware_keycode, event->state, event->group, &clean, &keyval) == false) {
+  if (clean_mask(session, event->hardware_keycode, event->state, event->group, &clean, &keyval) == false) {
     return false;
   }
 
+  session->private_data->latency.event_time = event->time;
+  return girara_key_dispatch(session, keyval, clean);
+}
+
+bool
+girara_key_dispatch(girara_session_t* session, guint keyval, guint clean)
+{
+  g_return_val_if_fail(session != NULL, FALSE);
+
+  if (girara_macro_key_press(session, keyval, clean) == true) {
+    return TRUE;
+  }
+
   /* prepare event */
-  GIRARA_LIST_FOREACH(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut)
+  GIRARA_LIST_FOREACH_STACK(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut)
     if (session->buffer.command != NULL) {
       break;
     }
@@ -98,12 +188,7 @@ girara_callback_view_key_press_event(GtkWidget* UNUSED(widget),
       && shortcut->function != NULL
       )
     {
-      int t = (session->buffer.n > 0) ? session->buffer.n : 1;
-      for (int i = 0; i < t; i++) {
-        if (shortcut->function(session, &(shortcut->argument), NULL, session->buffer.n) == false) {
-          break;
-        }
-      }
+      shortcut_execute(session, shortcut);
 
       if (session->global.buffer != NULL) {
         g_string_free(session->global.buffer, TRUE);
@@ -116,10 +201,9 @@ girara_callback_view_key_press_event(GtkWidget* UNUSED(widget),
         session->events.buffer_changed(session);
       }
 
-      girara_list_iterator_free(iter);
       return TRUE;
     }
-  GIRARA_LIST_FOREACH_END(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut);
+  GIRARA_LIST_FOREACH_STACK_END(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut);
 
   /* update buffer */
   if (keyval >= 0x21 && keyval <= 0x7E) {
@@ -151,7 +235,7 @@ girara_callback_view_key_press_event(GtkWidget* UNUSED(widget),
   if (session->buffer.command != NULL) {
     bool matching_command = FALSE;
 
-    GIRARA_LIST_FOREACH(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut)
+    GIRARA_LIST_FOREACH_STACK(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut)
       if (shortcut->buffered_command != NULL) {
         /* buffer could match a command */
         if (!strncmp(session->buffer.command->str, shortcut->buffered_command, session->buffer.command->len)) {
@@ -167,22 +251,16 @@ girara_callback_view_key_press_event(GtkWidget* UNUSED(widget),
               session->events.buffer_changed(session);
             }
 
-            int t = (session->buffer.n > 0) ? session->buffer.n : 1;
-            for (int i = 0; i < t; i++) {
-              if (shortcut->function(session, &(shortcut->argument), NULL, session->buffer.n) == false) {
-                break;
-              }
-            }
+            shortcut_execute(session, shortcut);
 
             session->buffer.n = 0;
-            girara_list_iterator_free(iter);
             return TRUE;
           }
 
           matching_command = TRUE;
         }
       }
-    GIRARA_LIST_FOREACH_END(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut);
+    GIRARA_LIST_FOREACH_STACK_END(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut);
 
     /* free buffer if buffer will never match a command */
     if (matching_command == false) {
@@ -201,6 +279,269 @@ girara_callback_view_key_press_event(GtkWidget* UNUSED(widget),
   return FALSE;
 }
 
+#if GTK_CHECK_VERSION(3, 8, 0)
+static void
+cb_mouse_event_tick_destroyed(gpointer data)
+{
+  girara_session_t* session = data;
+  session->private_data->mouse_event_tick = 0;
+}
+
+static gboolean
+cb_mouse_event_tick(GtkWidget* UNUSED(widget),
+    GdkFrameClock* UNUSED(frame_clock), gpointer data)
+{
+  girara_session_t* session = data;
+  girara_list_t* pending    = session->private_data->pending_mouse_events;
+
+  /* handlers might remove bindings that are still pending, so the list is
+   * checked again after each of them */
+  while (girara_list_size(pending) != 0) {
+    girara_mouse_event_t* mouse_event = girara_list_nth(pending, 0);
+    girara_list_remove(pending, mouse_event);
+
+    girara_event_t event = mouse_event->pending_event;
+    unsigned int t       = mouse_event->pending_count;
+    mouse_event->pending_count = 0;
+
+    /* only discrete scroll events report the number of collected steps */
+    if (event.type == GIRARA_EVENT_MOTION_NOTIFY ||
+        event.type == GIRARA_EVENT_SCROLL_BIDIRECTIONAL) {
+      t = session->buffer.n;
+    }
+
+    mouse_event_run(session, mouse_event, &event, t, mouse_event->pending_time);
+  }
+
+  return FALSE;
+}
+#endif
+
+static bool
+mouse_event_queue(girara_session_t* session, girara_mouse_event_t* mouse_event,
+    const girara_event_t* event)
+{
+#if GTK_CHECK_VERSION(3, 8, 0)
+  /* without a frame clock there is nothing to wait for */
+  if (session->gtk.view == NULL || gtk_widget_get_realized(session->gtk.view) == FALSE) {
+    return false;
+  }
+
+  /* smooth scroll deltas add up, everything else reports the last event */
+  if (mouse_event->pending_count != 0 && event->type == GIRARA_EVENT_SCROLL_BIDIRECTIONAL) {
+    const double dx = mouse_event->pending_event.dx;
+    const double dy = mouse_event->pending_event.dy;
+    mouse_event->pending_event     = *event;
+    mouse_event->pending_event.dx += dx;
+    mouse_event->pending_event.dy += dy;
+  } else {
+    mouse_event->pending_event = *event;
+  }
+
+  if (mouse_event->pending_count++ == 0) {
+    mouse_event->pending_time = session->private_data->latency.event_time;
+    girara_list_append(session->private_data->pending_mouse_events, mouse_event);
+  }
+
+  if (session->private_data->mouse_event_tick == 0) {
+    session->private_data->mouse_event_tick = gtk_widget_add_tick_callback(
+        session->gtk.view, cb_mouse_event_tick, session,
+        cb_mouse_event_tick_destroyed);
+  }
+
+  return true;
+#else
+  (void) session;
+  (void) mouse_event;
+  (void) event;
+  return false;
+#endif
+}
+
+static bool
+mouse_event_dispatch(girara_session_t* session, girara_mouse_event_t* mouse_event,
+    girara_event_t* event)
+{
+  if (mouse_event == NULL || mouse_event->function == NULL) {
+    return false;
+  }
+
+  if (mouse_event->coalesce == true && mouse_event_queue(session, mouse_event, event) == true) {
+    return true;
+  }
+
+  mouse_event_run(session, mouse_event, event, session->buffer.n,
+      session->private_data->latency.event_time);
+  return true;
+}
+
+#if GTK_CHECK_VERSION(3, 4, 0)
+static bool
+scroll_steps(girara_session_t* session, double* delta,
+    girara_event_type_t forward, girara_event_type_t backward)
+{
+  const girara_mode_t mode = session->modes.current_mode;
+  const guint state        = session->private_data->scroll.state;
+  bool handled             = false;
+
+  while (*delta >= 1.0 || *delta <= -1.0) {
+    girara_event_t event = {
+      .type = (*delta > 0) ? forward : backward,
+      .x    = session->private_data->scroll.x,
+      .y    = session->private_data->scroll.y
+    };
+    *delta += (*delta > 0) ? -1.0 : 1.0;
+
+    girara_mouse_event_t* mouse_event = girara_mouse_event_find(session,
+        event.type, mode, state, 0);
+    handled = mouse_event_dispatch(session, mouse_event, &event) || handled;
+  }
+
+  /* swallow partial steps of bound directions */
+  if (handled == false && *delta != 0) {
+    handled = girara_mouse_event_find(session, (*delta > 0) ? forward : backward,
+        mode, state, 0) != NULL;
+  }
+
+  return handled;
+}
+
+static bool
+scroll_smooth_dispatch(girara_session_t* session, double dx, double dy)
+{
+  girara_mouse_event_t* mouse_event = girara_mouse_event_find(session,
+      GIRARA_EVENT_SCROLL_BIDIRECTIONAL, session->modes.current_mode,
+      session->private_data->scroll.state, 0);
+  if (mouse_event != NULL) {
+    girara_event_t event = {
+      .type = GIRARA_EVENT_SCROLL_BIDIRECTIONAL,
+      .x    = session->private_data->scroll.x,
+      .y    = session->private_data->scroll.y,
+      .dx   = dx,
+      .dy   = dy
+    };
+
+    return mouse_event_dispatch(session, mouse_event, &event);
+  }
+
+  /* bindings for discrete scrolling see one event per full scroll unit */
+  session->private_data->scroll.dx += dx;
+  session->private_data->scroll.dy += dy;
+
+  const bool vertical = scroll_steps(session, &session->private_data->scroll.dy,
+      GIRARA_EVENT_SCROLL_DOWN, GIRARA_EVENT_SCROLL_UP);
+  const bool horizontal = scroll_steps(session, &session->private_data->scroll.dx,
+      GIRARA_EVENT_SCROLL_RIGHT, GIRARA_EVENT_SCROLL_LEFT);
+
+  return vertical || horizontal;
+}
+#endif
+
+#if GTK_CHECK_VERSION(3, 20, 0)
+static void
+cb_kinetic_scroll_destroyed(gpointer data)
+{
+  girara_session_t* session = data;
+  session->private_data->scroll.tick = 0;
+}
+
+static gboolean
+cb_kinetic_scroll_tick(GtkWidget* UNUSED(widget), GdkFrameClock* frame_clock,
+    gpointer data)
+{
+  girara_session_t* session = data;
+
+  const gint64 frame_time = gdk_frame_clock_get_frame_time(frame_clock);
+  const double elapsed    = (frame_time - session->private_data->scroll.frame_time) / 1000.0;
+  session->private_data->scroll.frame_time = frame_time;
+
+  const double dx = session->private_data->scroll.vx * elapsed;
+  const double dy = session->private_data->scroll.vy * elapsed;
+
+  const double friction = MAX(0.0, 1.0 - elapsed * KINETIC_FRICTION);
+  session->private_data->scroll.vx *= friction;
+  session->private_data->scroll.vy *= friction;
+
+  if (ABS(session->private_data->scroll.vx) < KINETIC_MIN_VELOCITY &&
+      ABS(session->private_data->scroll.vy) < KINETIC_MIN_VELOCITY) {
+    return FALSE;
+  }
+
+  /* kinetic steps are not caused by an event */
+  session->private_data->latency.event_time = GDK_CURRENT_TIME;
+  scroll_smooth_dispatch(session, dx, dy);
+  return TRUE;
+}
+
+static void
+kinetic_scroll_stop(girara_session_t* session)
+{
+  if (session->private_data->scroll.tick != 0) {
+    gtk_widget_remove_tick_callback(session->gtk.view,
+        session->private_data->scroll.tick);
+  }
+}
+
+static void
+kinetic_scroll_start(girara_session_t* session)
+{
+  bool kinetic_scrolling = false;
+  girara_setting_get(session, "kinetic-scrolling", &kinetic_scrolling);
+
+  GdkFrameClock* frame_clock = gtk_widget_get_frame_clock(session->gtk.view);
+  if (kinetic_scrolling == false || frame_clock == NULL ||
+      (ABS(session->private_data->scroll.vx) < KINETIC_MIN_VELOCITY &&
+       ABS(session->private_data->scroll.vy) < KINETIC_MIN_VELOCITY)) {
+    return;
+  }
+
+  session->private_data->scroll.frame_time = gdk_frame_clock_get_frame_time(frame_clock);
+  session->private_data->scroll.tick       = gtk_widget_add_tick_callback(
+      session->gtk.view, cb_kinetic_scroll_tick, session,
+      cb_kinetic_scroll_destroyed);
+}
+#endif
+
+#if GTK_CHECK_VERSION(3, 4, 0)
+static bool
+scroll_smooth(girara_session_t* session, GdkEventScroll* scroll, guint state)
+{
+  double dx = 0;
+  double dy = 0;
+  if (gdk_event_get_scroll_deltas((GdkEvent*) scroll, &dx, &dy) == FALSE) {
+    return false;
+  }
+
+  session->private_data->scroll.state = state;
+  session->private_data->scroll.x     = scroll->x;
+  session->private_data->scroll.y     = scroll->y;
+
+#if GTK_CHECK_VERSION(3, 20, 0)
+  kinetic_scroll_stop(session);
+
+  if (gdk_event_is_scroll_stop_event((GdkEvent*) scroll) == TRUE) {
+    kinetic_scroll_start(session);
+    session->private_data->scroll.time = 0;
+    return false;
+  }
+
+  /* track the velocity of the gesture for kinetic scrolling */
+  const guint32 interval = scroll->time - session->private_data->scroll.time;
+  if (session->private_data->scroll.time != 0 && interval > 0 &&
+      interval < KINETIC_MAX_INTERVAL) {
+    session->private_data->scroll.vx = (session->private_data->scroll.vx + dx / interval) / 2;
+    session->private_data->scroll.vy = (session->private_data->scroll.vy + dy / interval) / 2;
+  } else if (interval != 0) {
+    session->private_data->scroll.vx = 0;
+    session->private_data->scroll.vy = 0;
+  }
+  session->private_data->scroll.time = scroll->time;
+#endif
+
+  return scroll_smooth_dispatch(session, dx, dy);
+}
+#endif
+
 bool
 girara_callback_view_button_press_event(GtkWidget* UNUSED(widget),
     GdkEventButton* button, girara_session_t* session)
@@ -208,8 +549,14 @@ girara_callback_view_button_press_event(GtkWidget* UNUSED(widget),
   g_return_val_if_fail(session != NULL, false);
   g_return_val_if_fail(button  != NULL, false);
 
+#if GTK_CHECK_VERSION(3, 20, 0)
+  kinetic_scroll_stop(session);
+#endif
+
+  session->private_data->latency.event_time = button->time;
+
   /* prepare girara event */
-  girara_event_t event;
+  girara_event_t event = { 0 };
 
   switch (button->type) {
     case GDK_BUTTON_PRESS:
@@ -232,20 +579,10 @@ girara_callback_view_button_press_event(GtkWidget* UNUSED(widget),
   const guint state = button->state & MOUSE_MASK;
 
   /* search registered mouse events */
-  GIRARA_LIST_FOREACH(session->bindings.mouse_events, girara_mouse_event_t*, iter, mouse_event)
-    if (mouse_event->function != NULL
-        && button->button == mouse_event->button
-        && state  == mouse_event->mask
-        && mouse_event->event_type == event.type
-        && (session->modes.current_mode == mouse_event->mode || mouse_event->mode == 0)
-       ) {
-        mouse_event->function(session, &(mouse_event->argument), &event, session->buffer.n);
-        girara_list_iterator_free(iter);
-      return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->bindings.mouse_events, girara_mouse_event_t*, iter, mouse_event);
+  girara_mouse_event_t* mouse_event = girara_mouse_event_find(session,
+      event.type, session->modes.current_mode, state, button->button);
 
-  return false;
+  return mouse_event_dispatch(session, mouse_event, &event);
 }
 
 bool
@@ -254,8 +591,10 @@ girara_callback_view_button_release_event(GtkWidget* UNUSED(widget), GdkEventBut
   g_return_val_if_fail(session != NULL, false);
   g_return_val_if_fail(button  != NULL, false);
 
+  session->private_data->latency.event_time = button->time;
+
   /* prepare girara event */
-  girara_event_t event;
+  girara_event_t event = { 0 };
   event.type = GIRARA_EVENT_BUTTON_RELEASE;
   event.x    = button->x;
   event.y    = button->y;
@@ -263,20 +602,10 @@ girara_callback_view_button_release_event(GtkWidget* UNUSED(widget), GdkEventBut
   const guint state = button->state & MOUSE_MASK;
 
   /* search registered mouse events */
-  GIRARA_LIST_FOREACH(session->bindings.mouse_events, girara_mouse_event_t*, iter, mouse_event)
-    if (mouse_event->function != NULL
-        && button->button == mouse_event->button
-        && state  == mouse_event->mask
-        && mouse_event->event_type == GIRARA_EVENT_BUTTON_RELEASE
-        && (session->modes.current_mode == mouse_event->mode || mouse_event->mode == 0)
-       ) {
-        mouse_event->function(session, &(mouse_event->argument), &event, session->buffer.n);
-        girara_list_iterator_free(iter);
-      return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->bindings.mouse_events, girara_mouse_event_t*, iter, mouse_event);
+  girara_mouse_event_t* mouse_event = girara_mouse_event_find(session,
+      GIRARA_EVENT_BUTTON_RELEASE, session->modes.current_mode, state, button->button);
 
-  return false;
+  return mouse_event_dispatch(session, mouse_event, &event);
 }
 
 bool
@@ -285,6 +614,8 @@ girara_callback_view_button_motion_notify_event(GtkWidget* UNUSED(widget), GdkEv
   g_return_val_if_fail(session != NULL, false);
   g_return_val_if_fail(button  != NULL, false);
 
+  session->private_data->latency.event_time = button->time;
+
   /* prepare girara event */
   girara_event_t event = {
     .type = GIRARA_EVENT_MOTION_NOTIFY,
@@ -295,19 +626,10 @@ girara_callback_view_button_motion_notify_event(GtkWidget* UNUSED(widget), GdkEv
   const guint state = button->state & MOUSE_MASK;
 
   /* search registered mouse events */
-  GIRARA_LIST_FOREACH(session->bindings.mouse_events, girara_mouse_event_t*, iter, mouse_event)
-    if (mouse_event->function != NULL
-        && state  == mouse_event->mask
-        && mouse_event->event_type == event.type
-        && (session->modes.current_mode == mouse_event->mode || mouse_event->mode == 0)
-       ) {
-        mouse_event->function(session, &(mouse_event->argument), &event, session->buffer.n);
-        girara_list_iterator_free(iter);
-      return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->bindings.mouse_events, girara_mouse_event_t*, iter, mouse_event);
+  girara_mouse_event_t* mouse_event = girara_mouse_event_find(session,
+      event.type, session->modes.current_mode, state, 0);
 
-  return false;
+  return mouse_event_dispatch(session, mouse_event, &event);
 }
 
 bool
@@ -316,8 +638,12 @@ girara_callback_view_scroll_event(GtkWidget* UNUSED(widget), GdkEventScroll* scr
   g_return_val_if_fail(session != NULL, false);
   g_return_val_if_fail(scroll  != NULL, false);
 
+  session->private_data->latency.event_time = scroll->time;
+
+  const guint state = scroll->state & MOUSE_MASK;
+
   /* prepare girara event */
-  girara_event_t event;
+  girara_event_t event = { 0 };
   event.x    = scroll->x;
   event.y    = scroll->y;
 
@@ -334,27 +660,19 @@ girara_callback_view_scroll_event(GtkWidget* UNUSED(widget), GdkEventScroll* scr
     case GDK_SCROLL_RIGHT:
       event.type = GIRARA_EVENT_SCROLL_RIGHT;
       break;
+#if GTK_CHECK_VERSION(3, 4, 0)
+    case GDK_SCROLL_SMOOTH:
+      return scroll_smooth(session, scroll, state);
+#endif
     default:
       return false;
   }
 
-  const guint state = scroll->state & MOUSE_MASK;
-
   /* search registered mouse events */
-  /* TODO: Filter correct event */
-  GIRARA_LIST_FOREACH(session->bindings.mouse_events, girara_mouse_event_t*, iter, mouse_event)
-    if (mouse_event->function != NULL
-        && state  == mouse_event->mask
-        && mouse_event->event_type == event.type
-        && (session->modes.current_mode == mouse_event->mode || mouse_event->mode == 0)
-       ) {
-        mouse_event->function(session, &(mouse_event->argument), &event, session->buffer.n);
-        girara_list_iterator_free(iter);
-        return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->bindings.mouse_events, girara_mouse_event_t*, iter, mouse_event);
+  girara_mouse_event_t* mouse_event = girara_mouse_event_find(session,
+      event.type, session->modes.current_mode, state, 0);
 
-  return false;
+  return mouse_event_dispatch(session, mouse_event, &event);
 }
 
 bool
@@ -385,119 +703,46 @@ girara_callback_inputbar_activate(GtkEntry* entry, girara_session_t* session)
     return return_value;
   }
 
-  gchar *input = gtk_editable_get_chars(GTK_EDITABLE(entry), 1, -1);
-  if (input == NULL) {
+  gchar *line = gtk_editable_get_chars(GTK_EDITABLE(entry), 0, -1);
+  if (line == NULL) {
     girara_isc_abort(session, NULL, NULL, 0);
     return false;
   }
 
-  if (strlen(input) == 0) {
-    g_free(input);
+  if (line[0] == '\0' || *g_utf8_next_char(line) == '\0') {
+    g_free(line);
     girara_isc_abort(session, NULL, NULL, 0);
     return false;
   }
 
   /* append to command history */
-  const char* command = gtk_entry_get_text(entry);
-  girara_input_history_append(session->command_history, command);
-
-  /* parse input */
-  gchar** argv = NULL;
-  gint    argc = 0;
+  girara_input_history_append(session->command_history, line);
 
-  if (g_shell_parse_argv(input, &argc, &argv, NULL) == FALSE) {
-    g_free(input);
-    return false;
-  }
-
-  gchar *cmd = argv[0];
-
-  /* special commands */
-  char *identifier_s = gtk_editable_get_chars(GTK_EDITABLE(entry), 0, 1);
-  if (identifier_s == NULL) {
-    g_free(input);
-    g_strfreev(argv);
-    return false;
-  }
-
-  char identifier = identifier_s[0];
-  g_free(identifier_s);
-
-  GIRARA_LIST_FOREACH(session->bindings.special_commands, girara_special_command_t*, iter, special_command)
-    if (special_command->identifier == identifier) {
-      if (special_command->always != true) {
-        special_command->function(session, input, &(special_command->argument));
-      }
-
-      g_free(input);
-      g_strfreev(argv);
+  /* the activation is caused by the key press that is being handled */
+  const girara_command_line_result_t result = girara_command_line_run(session,
+      line, gtk_get_current_event_time());
+  g_free(line);
 
+  switch (result) {
+    case GIRARA_COMMAND_LINE_INVALID:
+      return false;
+    case GIRARA_COMMAND_LINE_SPECIAL:
       girara_isc_abort(session, NULL, NULL, 0);
-
-      girara_list_iterator_free(iter);
       return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->bindings.special_commands, girara_special_command_t*, iter, special_command);
-
-  /* search commands */
-  GIRARA_LIST_FOREACH(session->bindings.commands, girara_command_t*, iter, command)
-    if ((g_strcmp0(cmd, command->command) == 0) ||
-        (g_strcmp0(cmd, command->abbr)    == 0))
-    {
-      girara_list_t* argument_list = girara_list_new();
-      if (argument_list == NULL) {
-        g_free(input);
-        g_strfreev(argv);
-        girara_list_iterator_free(iter);
-        return false;
-      }
-
-      girara_list_set_free_function(argument_list, g_free);
-
-      for(int i = 1; i < argc; i++) {
-        char* argument = g_strdup(argv[i]);
-        girara_list_append(argument_list, (void*) argument);
-      }
-
-      command->function(session, argument_list);
-
-      girara_list_free(argument_list);
-      g_free(input);
-      g_strfreev(argv);
-
+    case GIRARA_COMMAND_LINE_COMMAND:
       girara_isc_abort(session, NULL, NULL, 0);
 
       if (session->global.autohide_inputbar == true) {
         gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar));
       }
-      gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar_dialog));
-      girara_list_iterator_free(iter);
-      return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->bindings.commands, girara_command_t*, iter, command);
-
-  /* check for unknown command event handler */
-  if (session->events.unknown_command != NULL) {
-    if (session->events.unknown_command(session, input) == true) {
-      g_strfreev(argv);
-      g_free(input);
-      girara_isc_abort(session, NULL, NULL, 0);
-
-      if (session->global.autohide_inputbar == true) {
-        gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar));
+      if (session->gtk.inputbar_dialog != NULL) {
+        gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar_dialog));
       }
-      gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar_dialog));
-
       return true;
-    }
+    default:
+      girara_isc_abort(session, NULL, NULL, 0);
+      return false;
   }
-
-  /* unhandled command */
-  girara_notify(session, GIRARA_ERROR, _("Not a valid command: %s"), cmd);
-  g_strfreev(argv);
-  girara_isc_abort(session, NULL, NULL, 0);
-
-  return false;
 }
 
 bool
@@ -515,30 +760,37 @@ girara_callback_inputbar_key_press_event(GtkWidget* entry, GdkEventKey* event, g
       if (session->global.autohide_inputbar == true) {
         gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar));
       }
-      gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar_dialog));
+      if (session->gtk.inputbar_dialog != NULL) {
+        gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar_dialog));
+      }
     }
   }
 
   guint keyval = 0;
   guint clean  = 0;
 
-  if (clean_mask(event->hardware_keycode, event->state, event->group, &clean, &keyval) == false) {
+  if (clean_mask(session, event->hardware_keycode, event->state, event->group, &clean, &keyval) == false) {
     return false;
   }
 
+  girara_macro_inputbar_key_press(session, event->keyval, event->state);
+
   if (custom_ret == false) {
-    GIRARA_LIST_FOREACH(session->bindings.inputbar_shortcuts, girara_inputbar_shortcut_t*, iter, inputbar_shortcut)
-      if (inputbar_shortcut->key == keyval
-       && inputbar_shortcut->mask == clean)
-      {
-        if (inputbar_shortcut->function != NULL) {
-          inputbar_shortcut->function(session, &(inputbar_shortcut->argument), NULL, 0);
-        }
+    girara_inputbar_shortcut_t* inputbar_shortcut =
+      girara_inputbar_shortcut_find(session, clean, keyval);
+    if (inputbar_shortcut != NULL) {
+      if (inputbar_shortcut->function != NULL) {
+        girara_profile_entry_t* profile = girara_profile_shortcut(session,
+            inputbar_shortcut->function);
+        const gint64 cpu_start = girara_profile_begin();
+
+        inputbar_shortcut->function(session, &(inputbar_shortcut->argument), NULL, 0);
 
-        girara_list_iterator_free(iter);
-        return true;
+        girara_profile_end(profile, cpu_start);
       }
-    GIRARA_LIST_FOREACH_END(session->bindings.inputbar_shortcuts, girara_inputbar_shortcut_t*, iter, inputbar_shortcut);
+
+      return true;
+    }
   }
 
   if ((session->gtk.results != NULL) &&
@@ -565,17 +817,26 @@ girara_callback_inputbar_changed_event(GtkEditable* entry, girara_session_t* ses
   char identifier    = identifier_s[0];
   g_free(identifier_s);
 
-  GIRARA_LIST_FOREACH(session->bindings.special_commands, girara_special_command_t*, iter, special_command)
-    if ((special_command->identifier == identifier) &&
-       (special_command->always == true))
-    {
-      gchar *input  = gtk_editable_get_chars(GTK_EDITABLE(entry), 1, -1);
-      special_command->function(session, input, &(special_command->argument));
-      g_free(input);
-      girara_list_iterator_free(iter);
-      return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->bindings.special_commands, girara_special_command_t*, iter, special_command);
+  girara_special_command_t* special_command =
+    session->private_data->special_command_table[(unsigned char) identifier];
+  if (special_command != NULL && special_command->always == false) {
+    special_command = NULL;
+  }
 
-  return false;
+  /* the input does not belong to the previous live command anymore */
+  girara_special_command_t* active = session->private_data->active_special_command;
+  if (active != NULL && active != special_command) {
+    girara_special_command_cancel(active);
+  }
+  session->private_data->active_special_command = special_command;
+
+  if (special_command == NULL) {
+    return false;
+  }
+
+  gchar *input  = gtk_editable_get_chars(GTK_EDITABLE(entry), 1, -1);
+  girara_special_command_update(special_command, input);
+  g_free(input);
+
+  return true;
 }
@@ -12,94 +12,38 @@
 #include "settings.h"
 #include "shortcuts.h"
 
+static bool
+map_special_name(const char* name, int* key, int* mouse_button,
+    girara_event_type_t* event_type, bool* mouse_event)
+{
+  const girara_special_name_t* special = girara_special_name_find(name);
+  if (special == NULL) {
+    return false;
+  }
+
+  switch (special->type) {
+    case GIRARA_SPECIAL_NAME_KEY:
+      *key = special->value;
+      return true;
+    case GIRARA_SPECIAL_NAME_BUTTON:
+      *mouse_button = special->value;
+      *mouse_event  = true;
+      return true;
+    case GIRARA_SPECIAL_NAME_EVENT:
+      *event_type  = special->value;
+      *mouse_event = true;
+      return true;
+    default:
+      /* button events are only valid as mouse mode */
+      return false;
+  }
+}
+
 /* default commands implementation */
 bool
 girara_cmd_map_unmap(girara_session_t* session, girara_list_t* argument_list,
     bool unmap)
 {
-  typedef struct gdk_keyboard_button_s
-  {
-    char* identifier;
-    int keyval;
-  } gdk_keyboard_button_t;
-
-  static const gdk_keyboard_button_t gdk_keyboard_buttons[] = {
-    {"BackSpace", GDK_KEY_BackSpace},
-    {"CapsLock",  GDK_KEY_Caps_Lock},
-    {"Down",      GDK_KEY_Down},
-    {"Esc",       GDK_KEY_Escape},
-    {"F10",       GDK_KEY_F10},
-    {"F11",       GDK_KEY_F11},
-    {"F12",       GDK_KEY_F12},
-    {"F1",        GDK_KEY_F1},
-    {"F2",        GDK_KEY_F2},
-    {"F3",        GDK_KEY_F3},
-    {"F4",        GDK_KEY_F4},
-    {"F5",        GDK_KEY_F5},
-    {"F6",        GDK_KEY_F6},
-    {"F7",        GDK_KEY_F7},
-    {"F8",        GDK_KEY_F8},
-    {"F9",        GDK_KEY_F9},
-    {"Left",      GDK_KEY_Left},
-    {"PageDown",  GDK_KEY_Page_Down},
-    {"PageUp",    GDK_KEY_Page_Up},
-    {"Home",      GDK_KEY_Home},
-    {"End",       GDK_KEY_End},
-    {"Return",    GDK_KEY_Return},
-    {"Right",     GDK_KEY_Right},
-    {"Space",     GDK_KEY_space},
-    {"Super",     GDK_KEY_Super_L},
-    {"Tab",       GDK_KEY_Tab},
-    {"ShiftTab",  GDK_KEY_ISO_Left_Tab},
-    {"Up",        GDK_KEY_Up},
-    {"Print",     GDK_KEY_Print}
-  };
-
-  typedef struct gdk_mouse_button_s
-  {
-    char* identifier;
-    int button;
-  } gdk_mouse_button_t;
-
-  static const gdk_mouse_button_t gdk_mouse_buttons[] = {
-    {"Button1", GIRARA_MOUSE_BUTTON1},
-    {"Button2", GIRARA_MOUSE_BUTTON2},
-    {"Button3", GIRARA_MOUSE_BUTTON3},
-    {"Button4", GIRARA_MOUSE_BUTTON4},
-    {"Button5", GIRARA_MOUSE_BUTTON5},
-    {"Button6", GIRARA_MOUSE_BUTTON6},
-    {"Button7", GIRARA_MOUSE_BUTTON7},
-    {"Button8", GIRARA_MOUSE_BUTTON8},
-    {"Button9", GIRARA_MOUSE_BUTTON9}
-  };
-
-  typedef struct event_type_s
-  {
-    char* identifier;
-    int event;
-  } event_type_t;
-
-  static const event_type_t event_types[] = {
-    {"motion",       GIRARA_EVENT_MOTION_NOTIFY},
-    {"scroll_up",    GIRARA_EVENT_SCROLL_UP},
-    {"scroll_down",  GIRARA_EVENT_SCROLL_DOWN},
-    {"scroll_left",  GIRARA_EVENT_SCROLL_LEFT},
-    {"scroll_right", GIRARA_EVENT_SCROLL_RIGHT}
-  };
-
-  typedef struct mouse_event_s
-  {
-    char* identifier;
-    int event;
-  } mouse_event_t;
-
-  static const mouse_event_t mouse_events[] = {
-    {"button-pressed",   GIRARA_EVENT_BUTTON_PRESS},
-    {"2-button-pressed", GIRARA_EVENT_2BUTTON_PRESS},
-    {"3-button-pressed", GIRARA_EVENT_2BUTTON_PRESS},
-    {"button-released",  GIRARA_EVENT_BUTTON_RELEASE}
-  };
-
   const size_t number_of_arguments = girara_list_size(argument_list);
 
   unsigned int limit = (unmap == true) ? 1 : 2;
@@ -130,13 +74,11 @@ girara_cmd_map_unmap(girara_session_t* session, girara_list_t* argument_list,
   if (tmp_length >= 3 && tmp[0] == '[' && tmp[tmp_length - 1] == ']') {
     char* tmp_inner = g_strndup(tmp + 1, tmp_length - 2);
 
-    GIRARA_LIST_FOREACH(session->modes.identifiers, girara_mode_string_t*, iter, mode)
-      if (!g_strcmp0(tmp_inner, mode->name)) {
-        shortcut_mode = mode->index;
-        is_mode       = true;
-        break;
-      }
-    GIRARA_LIST_FOREACH_END(session->modes.identifiers, girara_mode_string_t*, iter, mode);
+    const girara_mode_string_t* mode = girara_map_get(session->private_data->mode_index, tmp_inner);
+    if (mode != NULL) {
+      shortcut_mode = mode->index;
+      is_mode       = true;
+    }
 
     if (is_mode == false) {
       girara_warning("Unregistered mode specified: %s", tmp_inner);
@@ -182,32 +124,8 @@ girara_cmd_map_unmap(girara_session_t* session, girara_list_t* argument_list,
         shortcut_key = tmp[2];
       /* Possible special key */
       } else {
-        bool found = false;
-        for (unsigned int i = 0; i < LENGTH(gdk_keyboard_buttons); i++) {
-          if (g_strcmp0(tmp + 2, gdk_keyboard_buttons[i].identifier) == 0) {
-            shortcut_key = gdk_keyboard_buttons[i].keyval;
-            found = true;
-            break;
-          }
-        }
-
-        for (unsigned int i = 0; i < LENGTH(gdk_mouse_buttons); i++) {
-          if (!g_strcmp0(tmp + 2, gdk_mouse_buttons[i].identifier)) {
-            shortcut_mouse_button = gdk_mouse_buttons[i].button;
-            mouse_event = true;
-            found = true;
-            break;
-          }
-        }
-
-        for (unsigned int i = 0; i < LENGTH(event_types); i++) {
-          if (!g_strcmp0(tmp + 2, event_types[i].identifier)) {
-            event_type = event_types[i].event;
-            mouse_event = true;
-            found = true;
-            break;
-          }
-        }
+        const bool found = map_special_name(tmp + 2, &shortcut_key,
+            &shortcut_mouse_button, &event_type, &mouse_event);
 
         if (found == false) {
           girara_warning("Invalid special key value or mode: %s", tmp);
@@ -218,32 +136,8 @@ girara_cmd_map_unmap(girara_session_t* session, girara_list_t* argument_list,
       }
     /* Possible special key */
     } else {
-      bool found = false;
-      for (unsigned int i = 0; i < LENGTH(gdk_keyboard_buttons); i++) {
-        if (g_strcmp0(tmp, gdk_keyboard_buttons[i].identifier) == 0) {
-          shortcut_key = gdk_keyboard_buttons[i].keyval;
-          found = true;
-          break;
-        }
-      }
-
-      for (unsigned int i = 0; i < LENGTH(gdk_mouse_buttons); i++) {
-        if (!g_strcmp0(tmp, gdk_mouse_buttons[i].identifier)) {
-          shortcut_mouse_button = gdk_mouse_buttons[i].button;
-          mouse_event = true;
-          found = true;
-          break;
-        }
-      }
-
-      for (unsigned int i = 0; i < LENGTH(event_types); i++) {
-        if (!g_strcmp0(tmp, event_types[i].identifier)) {
-          event_type = event_types[i].event;
-          mouse_event = true;
-          found = true;
-          break;
-        }
-      }
+      const bool found = map_special_name(tmp, &shortcut_key,
+          &shortcut_mouse_button, &event_type, &mouse_event);
 
       if (found == false) {
         girara_warning("Invalid special key value or mode: %s", tmp);
@@ -278,13 +172,11 @@ girara_cmd_map_unmap(girara_session_t* session, girara_list_t* argument_list,
 
         char* tmp_inner = g_strndup(tmp + 1, tmp_length - 2);
 
-        bool found = false;
-        for (unsigned int i = 0; i < LENGTH(mouse_events); i++) {
-          if (!g_strcmp0(tmp_inner, mouse_events[i].identifier)) {
-            event_type = mouse_events[i].event;
-            found = true;
-            break;
-          }
+        const girara_special_name_t* special = girara_special_name_find(tmp_inner);
+        const bool found = special != NULL &&
+          special->type == GIRARA_SPECIAL_NAME_BUTTON_EVENT;
+        if (found == true) {
+          event_type = special->value;
         }
 
         if (found == false) {
@@ -317,14 +209,12 @@ girara_cmd_map_unmap(girara_session_t* session, girara_list_t* argument_list,
 
   /* Check for passed shortcut command */
   if (unmap == false) {
-    bool found_mapping = false;
-    GIRARA_LIST_FOREACH(session->config.shortcut_mappings, girara_shortcut_mapping_t*, iter, mapping)
-      if (!g_strcmp0(tmp, mapping->identifier)) {
-        shortcut_function = mapping->function;
-        found_mapping = true;
-        break;
-      }
-    GIRARA_LIST_FOREACH_END(session->config.shortcut_mappings, girara_shortcut_mapping_t*, iter, mapping);
+    const girara_shortcut_mapping_t* mapping = girara_map_get(
+        session->private_data->shortcut_mapping_index, tmp);
+    const bool found_mapping = mapping != NULL;
+    if (found_mapping == true) {
+      shortcut_function = mapping->function;
+    }
 
     if (found_mapping == false) {
       girara_warning("Not a valid shortcut function: %s", tmp);
@@ -341,12 +231,11 @@ girara_cmd_map_unmap(girara_session_t* session, girara_list_t* argument_list,
     if (++current_command < number_of_arguments) {
       tmp = (char*) girara_list_nth(argument_list, current_command);
 
-      GIRARA_LIST_FOREACH(session->config.argument_mappings, girara_argument_mapping_t*, iter, mapping)
-        if (!g_strcmp0(tmp, mapping->identifier)) {
-          shortcut_argument_n = mapping->value;
-          break;
-        }
-      GIRARA_LIST_FOREACH_END(session->config.argument_mappings, girara_argument_mapping_t*, iter, mapping);
+      const girara_argument_mapping_t* mapping = girara_map_get(
+          session->private_data->argument_mapping_index, tmp);
+      if (mapping != NULL) {
+        shortcut_argument_n = mapping->value;
+      }
 
       /* If no known argument is passed we save it in the data field */
       if (shortcut_argument_n == 0) {
@@ -404,7 +293,10 @@ girara_cmd_quit(girara_session_t* session, girara_list_t* UNUSED(argument_list))
   girara_argument_t arg = { GIRARA_HIDE, NULL };
   girara_isc_completion(session, &arg, NULL, 0);
 
-  gtk_main_quit();
+  /* headless sessions may not run a GTK main loop */
+  if (gtk_main_level() != 0) {
+    gtk_main_quit();
+  }
 
   return true;
 }
@@ -521,6 +413,117 @@ girara_cmd_set(girara_session_t* session, girara_list_t* argument_list)
   return true;
 }
 
+/* Position of the first key that is not smaller than the given one */
+static guint
+command_keys_lower_bound(GArray* keys, const char* key)
+{
+  guint lower = 0;
+  guint upper = keys->len;
+  while (lower < upper) {
+    const guint middle = lower + (upper - lower) / 2;
+    if (strcmp(g_array_index(keys, girara_command_key_t, middle).key, key) < 0) {
+      lower = middle + 1;
+    } else {
+      upper = middle;
+    }
+  }
+
+  return lower;
+}
+
+static void
+command_index_add(girara_session_t* session, girara_command_t* command,
+    const char* key)
+{
+  if (key == NULL) {
+    return;
+  }
+
+  /* names take precedence over abbreviations of other commands */
+  girara_command_t* existing = girara_map_get(session->private_data->command_index, key);
+  if (existing == NULL || g_strcmp0(existing->command, key) != 0) {
+    girara_map_set(session->private_data->command_index, key, command);
+  }
+
+  GArray* keys = session->private_data->command_keys;
+  girara_command_key_t entry = { key, command };
+  g_array_insert_val(keys, command_keys_lower_bound(keys, key), entry);
+}
+
+static void
+command_index_remove(girara_session_t* session, girara_command_t* command,
+    const char* key)
+{
+  if (key == NULL) {
+    return;
+  }
+
+  /* the name of the command itself stays in the index */
+  if (g_strcmp0(command->command, key) != 0 &&
+      girara_map_get(session->private_data->command_index, key) == command) {
+    girara_map_remove(session->private_data->command_index, key);
+
+    /* another command might use the same key */
+    GIRARA_LIST_FOREACH_STACK(session->bindings.commands, girara_command_t*, iter, command_it)
+      if (command_it != command && (g_strcmp0(command_it->command, key) == 0 ||
+            g_strcmp0(command_it->abbr, key) == 0)) {
+        girara_map_set(session->private_data->command_index, key, command_it);
+        break;
+      }
+    GIRARA_LIST_FOREACH_STACK_END(session->bindings.commands, girara_command_t*, iter, command_it);
+  }
+
+  GArray* keys = session->private_data->command_keys;
+  for (guint i = command_keys_lower_bound(keys, key); i < keys->len &&
+      strcmp(g_array_index(keys, girara_command_key_t, i).key, key) == 0; ++i) {
+    /* entries refer to the strings of the command, the name might match too */
+    if (g_array_index(keys, girara_command_key_t, i).key == key) {
+      g_array_remove_index(keys, i);
+      break;
+    }
+  }
+}
+
+girara_command_t*
+girara_command_find(girara_session_t* session, const char* name)
+{
+  if (name == NULL) {
+    return NULL;
+  }
+
+  return girara_map_get(session->private_data->command_index, name);
+}
+
+girara_list_t*
+girara_command_find_prefix(girara_session_t* session, const char* prefix)
+{
+  girara_list_t* commands = girara_list_new();
+  if (commands == NULL) {
+    return NULL;
+  }
+
+  if (prefix == NULL) {
+    prefix = "";
+  }
+
+  GArray* keys        = session->private_data->command_keys;
+  const size_t length = strlen(prefix);
+  for (guint i = command_keys_lower_bound(keys, prefix); i < keys->len; ++i) {
+    const girara_command_key_t* entry = &g_array_index(keys, girara_command_key_t, i);
+    if (strncmp(entry->key, prefix, length) != 0) {
+      break;
+    }
+
+    /* a command matching by name and abbreviation is listed under its name */
+    if (entry->key != entry->command->abbr ||
+        strncmp(entry->command->command, prefix, length) != 0) {
+      girara_list_append(commands, entry->command);
+    }
+  }
+
+  return commands;
+}
+
 bool
 girara_inputbar_command_add(girara_session_t* session, const char* command,
     const char* abbreviation, girara_command_function_t function,
@@ -531,30 +534,76 @@ girara_inputbar_command_add(girara_session_t* session, const char* command,
   g_return_val_if_fail(function != NULL, false);
 
   /* search for existing binding */
-  GIRARA_LIST_FOREACH(session->bindings.commands, girara_command_t*, iter, commands_it)
-    if (g_strcmp0(commands_it->command, command) == 0) {
-      g_free(commands_it->abbr);
-      g_free(commands_it->description);
-
-      commands_it->abbr        = abbreviation ? g_strdup(abbreviation) : NULL;
-      commands_it->function    = function;
-      commands_it->completion  = completion;
-      commands_it->description = description ? g_strdup(description) : NULL;
+  girara_command_t* commands_it = girara_command_find(session, command);
+  if (commands_it != NULL && g_strcmp0(commands_it->command, command) == 0) {
+    command_index_remove(session, commands_it, commands_it->abbr);
+    girara_session_strfree(session, commands_it->abbr);
+    girara_session_strfree(session, commands_it->description);
+
+    commands_it->abbr        = girara_session_strdup(session,
+        GIRARA_MEMORY_COMMANDS, abbreviation);
+    commands_it->function    = function;
+    commands_it->completion  = completion;
+    commands_it->description = girara_session_strdup(session,
+        GIRARA_MEMORY_COMMANDS, description);
+    command_index_add(session, commands_it, commands_it->abbr);
 
-      girara_list_iterator_free(iter);
-      return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->bindings.commands, girara_command_t*, iter, commands_it);
+    return true;
+  }
 
   /* add new inputbar command */
-  girara_command_t* new_command = g_slice_new(girara_command_t);
+  girara_command_t* new_command = girara_session_alloc(session,
+      GIRARA_MEMORY_COMMANDS, sizeof(girara_command_t));
 
-  new_command->command     = g_strdup(command);
-  new_command->abbr        = abbreviation ? g_strdup(abbreviation) : NULL;
+  new_command->command     = girara_session_strdup(session,
+      GIRARA_MEMORY_COMMANDS, command);
+  new_command->abbr        = girara_session_strdup(session,
+      GIRARA_MEMORY_COMMANDS, abbreviation);
   new_command->function    = function;
   new_command->completion  = completion;
-  new_command->description = description ? g_strdup(description) : NULL;
+  new_command->description = girara_session_strdup(session,
+      GIRARA_MEMORY_COMMANDS, description);
   girara_list_append(session->bindings.commands, new_command);
+  command_index_add(session, new_command, new_command->command);
+  command_index_add(session, new_command, new_command->abbr);
+
+  return true;
+}
+
+static bool
+special_command_add(girara_session_t* session, char identifier,
+    girara_inputbar_special_function_t function,
+    girara_inputbar_special_cancellable_function_t cancellable_function,
+    bool always, unsigned int debounce, girara_argument_t argument)
+{
+  /* search for existing special command */
+  girara_special_command_t* scommand_it =
+    session->private_data->special_command_table[(unsigned char) identifier];
+  if (scommand_it != NULL) {
+    girara_special_command_cancel(scommand_it);
+
+    scommand_it->function             = function;
+    scommand_it->cancellable_function = cancellable_function;
+    scommand_it->always               = always;
+    scommand_it->debounce             = debounce;
+    scommand_it->argument             = argument;
+    return true;
+  }
+
+  /* create new special command */
+  girara_special_command_t* special_command = girara_session_alloc(session,
+      GIRARA_MEMORY_COMMANDS, sizeof(girara_special_command_t));
+
+  special_command->identifier           = identifier;
+  special_command->function             = function;
+  special_command->cancellable_function = cancellable_function;
+  special_command->always               = always;
+  special_command->debounce             = debounce;
+  special_command->argument             = argument;
+  special_command->session              = session;
+
+  girara_list_append(session->bindings.special_commands, special_command);
+  session->private_data->special_command_table[(unsigned char) identifier] = special_command;
 
   return true;
 }
@@ -567,28 +616,123 @@ girara_special_command_add(girara_session_t* session, char identifier, girara_in
 
   girara_argument_t argument = {argument_n, argument_data};
 
-  /* search for existing special command */
-  GIRARA_LIST_FOREACH(session->bindings.special_commands, girara_special_command_t*, iter, scommand_it)
-    if (scommand_it->identifier == identifier) {
-      scommand_it->function = function;
-      scommand_it->always   = always;
-      scommand_it->argument = argument;
-      girara_list_iterator_free(iter);
-      return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->bindings.special_commands, girara_special_command_t*, iter, scommand_it);
+  return special_command_add(session, identifier, function, NULL, always, 0,
+      argument);
+}
 
-  /* create new special command */
-  girara_special_command_t* special_command = g_slice_new(girara_special_command_t);
+bool
+girara_special_command_add_cancellable(girara_session_t* session,
+    char identifier, girara_inputbar_special_cancellable_function_t function,
+    bool always, unsigned int debounce, int argument_n, void* argument_data)
+{
+  g_return_val_if_fail(session  != NULL, false);
+  g_return_val_if_fail(function != NULL, false);
 
-  special_command->identifier = identifier;
-  special_command->function   = function;
-  special_command->always     = always;
-  special_command->argument   = argument;
+  girara_argument_t argument = {argument_n, argument_data};
 
-  girara_list_append(session->bindings.special_commands, special_command);
+  return special_command_add(session, identifier, NULL, function, always,
+      always == true ? debounce : 0, argument);
+}
 
-  return true;
+static void
+special_command_stop(girara_special_command_t* special_command)
+{
+  if (special_command->timeout != 0) {
+    g_source_remove(special_command->timeout);
+    special_command->timeout = 0;
+  }
+
+  g_free(special_command->pending_input);
+  special_command->pending_input = NULL;
+
+  if (special_command->cancellable != NULL) {
+    g_cancellable_cancel(special_command->cancellable);
+    g_object_unref(special_command->cancellable);
+    special_command->cancellable = NULL;
+  }
+}
+
+static void
+special_command_execute(girara_special_command_t* special_command,
+    const char* input)
+{
+  special_command_stop(special_command);
+
+  if (special_command->cancellable_function == NULL) {
+    special_command->function(special_command->session, input,
+        &(special_command->argument));
+    return;
+  }
+
+  special_command->cancellable = g_cancellable_new();
+  special_command->cancellable_function(special_command->session, input,
+      &(special_command->argument), special_command->cancellable);
+}
+
+static gboolean
+cb_special_command_debounce(gpointer data)
+{
+  girara_special_command_t* special_command = data;
+
+  char* input = special_command->pending_input;
+  special_command->pending_input = NULL;
+  special_command->timeout       = 0;
+
+  special_command_execute(special_command, input);
+  g_free(input);
+
+  return FALSE;
+}
+
+void
+girara_special_command_cancel(girara_special_command_t* special_command)
+{
+  special_command_stop(special_command);
+
+  /* cancelled results do not count as seen */
+  g_free(special_command->live_input);
+  special_command->live_input = NULL;
+}
+
+void
+girara_special_command_update(girara_special_command_t* special_command,
+    const char* input)
+{
+  if (special_command->debounce == 0) {
+    special_command_execute(special_command, input);
+  } else {
+    /* only the input that is left once typing pauses is evaluated */
+    special_command_stop(special_command);
+    special_command->pending_input = g_strdup(input);
+    special_command->timeout       = g_timeout_add(special_command->debounce,
+        cb_special_command_debounce, special_command);
+  }
+
+  g_free(special_command->live_input);
+  special_command->live_input = g_strdup(input);
+}
+
+void
+girara_special_command_activate(girara_special_command_t* special_command,
+    const char* input)
+{
+  /* live commands already saw the final input in the inputbar unless it is
+   * still pending; lines that are run otherwise have not been seen */
+  const bool seen = special_command->always == true &&
+    special_command->timeout == 0 &&
+    g_strcmp0(special_command->live_input, input) == 0;
+  if (seen == false) {
+    special_command_execute(special_command, input);
+  }
+
+  g_free(special_command->live_input);
+  special_command->live_input = NULL;
+
+  /* clearing the inputbar afterwards must not cancel the final execution */
+  if (special_command->cancellable != NULL) {
+    g_object_unref(special_command->cancellable);
+    special_command->cancellable = NULL;
+  }
 }
 
 void
@@ -597,6 +741,8 @@ girara_special_command_free(girara_special_command_t* special_command)
   if (special_command == NULL) {
     return;
   }
+
+  girara_special_command_cancel(special_command);
   g_slice_free(girara_special_command_t, special_command);
 }
 
@@ -613,6 +759,123 @@ girara_command_free(girara_command_t* command)
   g_slice_free(girara_command_t, command);
 }
 
+girara_command_line_result_t
+girara_command_line_run(girara_session_t* session, const char* line,
+    guint32 event_time)
+{
+  /* the first character identifies special commands */
+  const char identifier = line[0];
+  if (identifier == '\0') {
+    return GIRARA_COMMAND_LINE_INVALID;
+  }
+
+  const char* input = g_utf8_next_char(line);
+  if (input[0] == '\0') {
+    return GIRARA_COMMAND_LINE_INVALID;
+  }
+
+  /* parse input */
+  gchar** argv = NULL;
+  gint    argc = 0;
+
+  if (g_shell_parse_argv(input, &argc, &argv, NULL) == FALSE) {
+    return GIRARA_COMMAND_LINE_INVALID;
+  }
+
+  gchar *cmd = argv[0];
+
+  /* special commands */
+  girara_special_command_t* special_command =
+    session->private_data->special_command_table[(unsigned char) identifier];
+  if (special_command != NULL) {
+    if (special_command->latency == NULL) {
+      /* keep apart from a shortcut bound to the identifier key */
+      char* name = g_strdup_printf("<special:%c>", identifier);
+      special_command->latency = girara_latency_get(session, name);
+      g_free(name);
+    }
+
+    girara_latency_t* latency = special_command->latency;
+    const gint64 start        = g_get_monotonic_time();
+
+    girara_special_command_activate(special_command, input);
+
+    girara_latency_record(session, GIRARA_LATENCY_INPUTBAR_ACTIVATE, latency,
+        event_time, start);
+
+    g_strfreev(argv);
+    return GIRARA_COMMAND_LINE_SPECIAL;
+  }
+
+  /* search commands */
+  girara_command_t* inputbar_command = girara_command_find(session, cmd);
+  if (inputbar_command != NULL) {
+    girara_list_t* argument_list = girara_list_new();
+    if (argument_list == NULL) {
+      g_strfreev(argv);
+      return GIRARA_COMMAND_LINE_INVALID;
+    }
+
+    girara_list_set_free_function(argument_list, g_free);
+
+    for(int i = 1; i < argc; i++) {
+      char* argument = g_strdup(argv[i]);
+      girara_list_append(argument_list, (void*) argument);
+    }
+
+    if (inputbar_command->latency == NULL) {
+      char* name = g_strconcat(":", inputbar_command->command, NULL);
+      inputbar_command->latency = girara_latency_get(session, name);
+      g_free(name);
+    }
+
+    girara_latency_t* latency = inputbar_command->latency;
+    const gint64 start        = g_get_monotonic_time();
+
+    girara_profile_entry_t* profile = girara_profile_command(session,
+        inputbar_command->command);
+    const gint64 cpu_start = girara_profile_begin();
+
+    inputbar_command->function(session, argument_list);
+
+    girara_profile_end(profile, cpu_start);
+
+    girara_latency_record(session, GIRARA_LATENCY_INPUTBAR_ACTIVATE, latency,
+        event_time, start);
+
+    girara_list_free(argument_list);
+    g_strfreev(argv);
+    return GIRARA_COMMAND_LINE_COMMAND;
+  }
+
+  /* check for unknown command event handler */
+  if (session->events.unknown_command != NULL) {
+    if (session->events.unknown_command(session, input) == true) {
+      g_strfreev(argv);
+      return GIRARA_COMMAND_LINE_COMMAND;
+    }
+  }
+
+  /* unhandled command */
+  girara_notify(session, GIRARA_ERROR, _("Not a valid command: %s"), cmd);
+  g_strfreev(argv);
+
+  return GIRARA_COMMAND_LINE_UNKNOWN;
+}
+
+bool
+girara_command_run(girara_session_t* session, const char* line)
+{
+  g_return_val_if_fail(session != NULL, false);
+  g_return_val_if_fail(line != NULL, false);
+
+  const girara_command_line_result_t result = girara_command_line_run(session,
+      line, GDK_CURRENT_TIME);
+
+  return result == GIRARA_COMMAND_LINE_SPECIAL ||
+    result == GIRARA_COMMAND_LINE_COMMAND;
+}
+
 bool
 girara_cmd_exec(girara_session_t* session, girara_list_t* argument_list)
 {
@@ -3,8 +3,25 @@
 #ifndef GIRARA_COMMANDS_H
 #define GIRARA_COMMANDS_H
 
+#include <gio/gio.h>
+
 #include "types.h"
 
+/**
+ * Function declaration of a cancellable inputbar special function
+ *
+ * @param session The current girara session
+ * @param input The current input
+ * @param argument The given argument
+ * @param cancellable Cancelled as soon as the input changes again; take a
+ *        reference to keep it beyond the call
+ * @return TRUE No error occured
+ * @return FALSE Error occured
+ */
+typedef bool (*girara_inputbar_special_cancellable_function_t)(
+    girara_session_t* session, const char* input, girara_argument_t* argument,
+    GCancellable* cancellable);
+
 /**
  * Adds an inputbar command
  *
@@ -39,4 +56,36 @@ bool girara_special_command_add(girara_session_t* session, char identifier,
     girara_inputbar_special_function_t function, bool always, int argument_n,
     void* argument_data);
 
+/**
+ * Adds a special command whose function can be cancelled. If the command is
+ * evaluated on every change of the input, it is only executed once the input
+ * did not change for the given debounce interval. The cancellable passed to
+ * the function is cancelled once newer input supersedes the current one.
+ *
+ * @param session The used girara session
+ * @param identifier Char identifier
+ * @param function Executed function
+ * @param always If the function should executed on every change of the input
+ *        (e.g.: incremental search)
+ * @param debounce Milliseconds to wait for further input (0 to disable)
+ * @param argument_n Argument identifier
+ * @param argument_data Argument data
+ * @return TRUE No error occured
+ * @return FALSE An error occured
+ */
+bool girara_special_command_add_cancellable(girara_session_t* session,
+    char identifier, girara_inputbar_special_cancellable_function_t function,
+    bool always, unsigned int debounce, int argument_n, void* argument_data);
+
+/**
+ * Runs a line as if it was entered into the inputbar, e.g. ":set font
+ * monospace" or "/pattern". The line is neither shown nor added to the
+ * command history, so this also works for headless sessions.
+ *
+ * @param session The used girara session
+ * @param line The line including the leading command identifier
+ * @return true if a command or special command handled the line
+ */
+bool girara_command_run(girara_session_t* session, const char* line);
+
 #endif
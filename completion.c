@@ -140,6 +140,11 @@ girara_isc_completion(girara_session_t* session, girara_argument_t* argument, gi
 {
   g_return_val_if_fail(session != NULL, false);
 
+  /* headless sessions have no inputbar */
+  if (session->gtk.inputbar_entry == NULL) {
+    return false;
+  }
+
   /* get current text */
   gchar *input = gtk_editable_get_chars(GTK_EDITABLE(session->gtk.inputbar_entry), 0, -1);
   if (input == NULL) {
@@ -179,8 +184,6 @@ girara_isc_completion(girara_session_t* session, girara_argument_t* argument, gi
   gchar *current_command   = (elements[0] != NULL && elements[0][0] != '\0') ? g_strdup(elements[0]) : NULL;
   gchar *current_parameter = (elements[0] != NULL && elements[1] != NULL)    ? g_strdup(elements[1]) : NULL;
 
-  size_t current_command_length = current_command ? strlen(current_command) : 0;
-
   static GList* entries           = NULL;
   static GList* entries_current   = NULL;
   static char *previous_command   = NULL;
@@ -259,24 +262,20 @@ girara_isc_completion(girara_session_t* session, girara_argument_t* argument, gi
       command_mode = true;
 
       /* create command rows */
-      GIRARA_LIST_FOREACH(session->bindings.commands, girara_command_t*, iter, command)
-        if (current_command == NULL ||
-            (command->command != NULL && !strncmp(current_command, command->command, current_command_length)) ||
-            (command->abbr != NULL && !strncmp(current_command, command->abbr,    current_command_length))
-          )
-        {
-          /* create entry */
-          girara_internal_completion_entry_t* entry = g_slice_new(girara_internal_completion_entry_t);
-          entry->group  = FALSE;
-          entry->value  = g_strdup(command->command);
-          entry->widget = girara_completion_row_create(command->command, command->description, FALSE);
-
-          entries = g_list_append(entries, entry);
-
-          /* show entry row */
-          gtk_box_pack_start(session->gtk.results, GTK_WIDGET(entry->widget), FALSE, FALSE, 0);
-        }
-      GIRARA_LIST_FOREACH_END(session->bindings.commands, girara_command_t*, iter, command);
+      girara_list_t* commands = girara_command_find_prefix(session, current_command);
+      GIRARA_LIST_FOREACH_STACK(commands, girara_command_t*, iter, command)
+        /* create entry */
+        girara_internal_completion_entry_t* entry = g_slice_new(girara_internal_completion_entry_t);
+        entry->group  = FALSE;
+        entry->value  = g_strdup(command->command);
+        entry->widget = girara_completion_row_create(command->command, command->description, FALSE);
+
+        entries = g_list_append(entries, entry);
+
+        /* show entry row */
+        gtk_box_pack_start(session->gtk.results, GTK_WIDGET(entry->widget), FALSE, FALSE, 0);
+      GIRARA_LIST_FOREACH_STACK_END(commands, girara_command_t*, iter, command);
+      girara_list_free(commands);
     }
 
     /* based on parameters */
@@ -288,7 +287,6 @@ girara_isc_completion(girara_session_t* session, girara_argument_t* argument, gi
         /* unset command mode */
         command_mode           = false;
         current_command        = entry->value;
-        current_command_length = strlen(current_command);
 
         /* clear list */
         gtk_widget_destroy(GTK_WIDGET(entry->widget));
@@ -297,19 +295,20 @@ girara_isc_completion(girara_session_t* session, girara_argument_t* argument, gi
         g_slice_free(girara_internal_completion_entry_t, entry);
       }
 
-      /* search matching command */
-      girara_command_t* command = NULL;
-      GIRARA_LIST_FOREACH(session->bindings.commands, girara_command_t*, iter, command_it)
-        if ( (current_command != NULL && command_it->command != NULL && !strncmp(current_command, command_it->command, current_command_length)) ||
-             (current_command != NULL && command_it->abbr != NULL    && !strncmp(current_command, command_it->abbr,    current_command_length))
-          )
-        {
-          g_free(previous_command);
-          previous_command = g_strdup(command_it->command);
-          command = command_it;
-          break;
+      /* search matching command, preferring exact matches */
+      girara_command_t* command = girara_command_find(session, current_command);
+      if (command == NULL && current_command != NULL) {
+        girara_list_t* commands = girara_command_find_prefix(session, current_command);
+        if (girara_list_size(commands) > 0) {
+          command = girara_list_nth(commands, 0);
         }
-      GIRARA_LIST_FOREACH_END(session->bindings.commands, girara_command_t*, iter, command_it);
+        girara_list_free(commands);
+      }
+
+      if (command != NULL) {
+        g_free(previous_command);
+        previous_command = g_strdup(command->command);
+      }
 
       if (command == NULL) {
         g_free(current_command);
@@ -344,7 +343,7 @@ girara_isc_completion(girara_session_t* session, girara_argument_t* argument, gi
           return false;
         }
 
-        GIRARA_LIST_FOREACH(result->groups, girara_completion_group_t*, iter, group)
+        GIRARA_LIST_FOREACH_STACK(result->groups, girara_completion_group_t*, iter, group)
           /* create group entry */
           if (group->value != NULL) {
             girara_internal_completion_entry_t* entry = g_slice_new(girara_internal_completion_entry_t);
@@ -357,7 +356,7 @@ girara_isc_completion(girara_session_t* session, girara_argument_t* argument, gi
             gtk_box_pack_start(session->gtk.results, GTK_WIDGET(entry->widget), FALSE, FALSE, 0);
           }
 
-          GIRARA_LIST_FOREACH(group->elements, girara_completion_element_t*, iter2, element)
+          GIRARA_LIST_FOREACH_STACK(group->elements, girara_completion_element_t*, iter2, element)
             girara_internal_completion_entry_t* entry = g_slice_new(girara_internal_completion_entry_t);
             entry->group  = FALSE;
             entry->value  = g_strdup(element->value);
@@ -367,8 +366,8 @@ girara_isc_completion(girara_session_t* session, girara_argument_t* argument, gi
 
             gtk_box_pack_start(session->gtk.results, GTK_WIDGET(entry->widget), FALSE, FALSE, 0);
 
-          GIRARA_LIST_FOREACH_END(group->elements, girara_completion_element_t*, iter2, element);
-        GIRARA_LIST_FOREACH_END(result->groups, girara_completion_group_t*, iter, group);
+          GIRARA_LIST_FOREACH_STACK_END(group->elements, girara_completion_element_t*, iter2, element);
+        GIRARA_LIST_FOREACH_STACK_END(result->groups, girara_completion_group_t*, iter, group);
         girara_completion_free(result);
 
         command_mode = false;
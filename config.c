@@ -100,19 +100,23 @@ cb_guioptions(girara_session_t* session, const char* UNUSED(name),
   }
 
   /* apply settings */
+  session->global.autohide_inputbar = !show_commandline;
+  session->global.hide_statusbar    = !show_statusbar;
+
+  /* headless sessions only keep track of the values */
+  if (session->gtk.view == NULL) {
+    return;
+  }
+
   if (show_commandline == true) {
-    session->global.autohide_inputbar = false;
     gtk_widget_show(session->gtk.inputbar);
   } else {
-    session->global.autohide_inputbar = true;
     gtk_widget_hide(session->gtk.inputbar);
   }
 
   if (show_statusbar == true) {
-    session->global.hide_statusbar = false;
     gtk_widget_show(session->gtk.statusbar);
   } else {
-    session->global.hide_statusbar = true;
     gtk_widget_hide(session->gtk.statusbar);
   }
 
@@ -202,6 +206,8 @@ girara_config_load_default(girara_session_t* session)
   int window_height         = 600;
   int n_completion_items    = 15;
   bool show_scrollbars      = false;
+  bool kinetic_scrolling    = false;
+  bool exec_output          = false;
   girara_mode_t normal_mode = session->modes.normal;
 
   /* other values */
@@ -242,7 +248,9 @@ girara_config_load_default(girara_session_t* session)
   girara_setting_add(session, "show-v-scrollbar",         &show_scrollbars,     BOOLEAN, FALSE, _("Show the vertical scrollbar"), cb_scrollbars, NULL);
   girara_setting_add(session, "window-icon",              "",                   STRING,  FALSE, _("Window icon"), cb_window_icon, NULL);
   girara_setting_add(session, "exec-command",             "",                   STRING,  FALSE, _("Command to execute in :exec"), NULL, NULL);
+  girara_setting_add(session, "exec-output",              &exec_output,         BOOLEAN, FALSE, _("Show the output of :exec"), NULL, NULL);
   girara_setting_add(session, "guioptions",               "s",                  STRING,  FALSE, _("Show or hide certain GUI elements"), cb_guioptions, NULL);
+  girara_setting_add(session, "kinetic-scrolling",        &kinetic_scrolling,   BOOLEAN, FALSE, _("Keep scrolling after a smooth scroll gesture ends"), NULL, NULL);
 
   /* shortcuts */
   girara_shortcut_add(session, 0,                GDK_KEY_Escape, NULL, girara_sc_abort,           normal_mode, 0, NULL);
@@ -279,6 +287,7 @@ girara_config_load_default(girara_session_t* session)
 
   /* commands */
   girara_inputbar_command_add(session, "exec",  NULL, girara_cmd_exec,  NULL,          _("Execute a command"));
+  girara_inputbar_command_add(session, "latency", NULL, girara_cmd_latency, NULL,      _("Show input latencies"));
   girara_inputbar_command_add(session, "map",   "m",  girara_cmd_map,   NULL,          _("Map a key sequence"));
   girara_inputbar_command_add(session, "quit",  "q",  girara_cmd_quit,  NULL,          _("Quit the program"));
   girara_inputbar_command_add(session, "set",   "s",  girara_cmd_set,   girara_cc_set, _("Set an option"));
@@ -294,6 +303,8 @@ girara_config_load_default(girara_session_t* session)
   girara_shortcut_mapping_add(session, "quit",           girara_sc_quit);
   girara_shortcut_mapping_add(session, "set",            girara_sc_set);
   girara_shortcut_mapping_add(session, "feedkeys",       girara_sc_feedkeys);
+  girara_shortcut_mapping_add(session, "macro_record",   girara_sc_macro_record);
+  girara_shortcut_mapping_add(session, "macro_replay",   girara_sc_macro_replay);
   girara_shortcut_mapping_add(session, "tab_next",       girara_sc_tab_navigate_next);
   girara_shortcut_mapping_add(session, "tab_prev",       girara_sc_tab_navigate_prev);
 }
@@ -305,20 +316,21 @@ girara_config_handle_add(girara_session_t* session, const char* identifier, gira
   g_return_val_if_fail(identifier != NULL, false);
 
   /* search for existing config handle */
-  GIRARA_LIST_FOREACH(session->config.handles, girara_config_handle_t*, iter, data)
-    if (strcmp(data->identifier, identifier) == 0) {
-      data->handle = handle;
-      girara_list_iterator_free(iter);
-      return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->config.handles, girara_config_handle_t*, iter, data);
+  girara_config_handle_t* data = girara_map_get(session->private_data->config_handles, identifier);
+  if (data != NULL) {
+    data->handle = handle;
+    return true;
+  }
 
   /* add new config handle */
-  girara_config_handle_t* config_handle = g_slice_new(girara_config_handle_t);
+  girara_config_handle_t* config_handle = girara_session_alloc(session,
+      GIRARA_MEMORY_CONFIG, sizeof(girara_config_handle_t));
 
-  config_handle->identifier = g_strdup(identifier);
+  config_handle->identifier = girara_session_strdup(session,
+      GIRARA_MEMORY_CONFIG, identifier);
   config_handle->handle     = handle;
   girara_list_append(session->config.handles, config_handle);
+  girara_map_set(session->private_data->config_handles, config_handle->identifier, config_handle);
 
   return true;
 }
@@ -397,7 +409,10 @@ config_parse(girara_session_t* session, const char* path)
           girara_warning("Could not process line %d in '%s': trying to include itself.", line_number, path);
         } else {
           girara_debug("Loading config file '%s'.", newpath);
-          if (config_parse(session, newpath) == FALSE) {
+          const gint64 trace = girara_trace_begin();
+          const bool included = config_parse(session, newpath);
+          girara_trace_end("include", newpath, trace);
+          if (included == false) {
             girara_warning("Could not process line %d in '%s': failed to load '%s'.", line_number, path, newpath);
           }
         }
@@ -405,18 +420,16 @@ config_parse(girara_session_t* session, const char* path)
       }
     } else {
       /* search for config handle */
-      girara_config_handle_t* handle = NULL;
-      GIRARA_LIST_FOREACH(session->config.handles, girara_config_handle_t*, iter, tmp)
-        handle = tmp;
-        if (strcmp(handle->identifier, argv[0]) == 0) {
-          handle->handle(session, argument_list);
-          break;
-        } else {
-          handle = NULL;
-        }
-      GIRARA_LIST_FOREACH_END(session->config.handles, girara_config_handle_t*, iter, tmp);
+      girara_config_handle_t* handle = girara_map_get(session->private_data->config_handles, argv[0]);
+      if (handle != NULL) {
+        girara_profile_entry_t* profile = girara_profile_command(session,
+            handle->identifier);
+        const gint64 cpu_start = girara_profile_begin();
+
+        handle->handle(session, argument_list);
 
-      if (handle == NULL) {
+        girara_profile_end(profile, cpu_start);
+      } else {
         girara_warning("Could not process line %d in '%s': Unknown handle '%s'", line_number, path, argv[0]);
       }
     }
@@ -434,5 +447,12 @@ config_parse(girara_session_t* session, const char* path)
 void
 girara_config_parse(girara_session_t* session, const char* path)
 {
+  const gint64 trace = girara_trace_begin();
+
+  /* keymaps are merged with the existing shortcuts at once */
+  girara_shortcut_transaction_begin(session);
   config_parse(session, path);
+  girara_shortcut_transaction_commit(session);
+
+  girara_trace_end("girara_config_parse", path, trace);
 }
@@ -1,6 +1,7 @@
 /* See LICENSE file for license and copyright information */
 
 #include <stdlib.h>
+#include <stdint.h>
 #include <glib.h>
 
 #include "datastructures.h"
@@ -9,27 +10,132 @@
 struct girara_tree_node_s
 {
   girara_free_function_t free; /**> The free function */
-  GNode* node; /* The node object */
-};
-
-typedef struct girara_tree_node_data_s
-{
-  girara_tree_node_t* node; /**> The node */
+  girara_tree_node_t* parent; /**> The parent node */
+  girara_tree_node_t** children; /**> The child nodes */
+  size_t num_children; /**> Number of child nodes */
+  size_t capacity; /**> Size of the children array */
+  size_t index; /**> Position in the parent's children array */
   void* data; /**> The data */
-} girara_tree_node_data_t;
+  girara_node_loader_function_t loader; /**> Populates the children on demand */
+  void* loader_data; /**> Data passed to the loader */
+  bool loaded; /**> The loader has been called */
+};
 
 struct girara_list_s
 {
   girara_free_function_t free; /**> The free function */
   girara_compare_function_t cmp; /**> The sort function */
   GList* start; /**> List start */
+  GSequence* index; /**> Balanced index of the elements of sorted lists */
 };
 
-struct girara_list_iterator_s
+static gint
+sorted_list_compare(gconstpointer a, gconstpointer b, gpointer data)
 {
-  girara_list_t* list; /**> The list */
-  GList* element; /**> The list object */
-};
+  const girara_list_t* list = data;
+  return list->cmp(((const GList*) a)->data, ((const GList*) b)->data);
+}
+
+/* Find the index entry of link, or of the first element holding data if link
+ * is NULL. Only elements comparing equal to data need to be checked. */
+static GSequenceIter*
+sorted_list_lookup(girara_list_t* list, const void* data, const GList* link)
+{
+  GList probe = { .data = (void*) data, .next = NULL, .prev = NULL };
+
+  /* g_sequence_search returns the position after the last equal element */
+  GSequenceIter* iter = g_sequence_search(list->index, &probe,
+      sorted_list_compare, list);
+  GSequenceIter* found = NULL;
+  while (g_sequence_iter_is_begin(iter) == FALSE) {
+    iter = g_sequence_iter_prev(iter);
+
+    const GList* entry = g_sequence_get(iter);
+    if (link != NULL && entry == link) {
+      return iter;
+    } else if (link == NULL && entry->data == data) {
+      found = iter;
+    } else if (list->cmp(entry->data, data) != 0) {
+      break;
+    }
+  }
+
+  return found;
+}
+
+static void
+sorted_list_insert(girara_list_t* list, void* data)
+{
+  GList* link = g_list_alloc();
+  link->data  = data;
+  link->prev  = NULL;
+  link->next  = NULL;
+
+  GSequenceIter* iter = g_sequence_insert_sorted(list->index, link,
+      sorted_list_compare, list);
+
+  /* link the new element in after its predecessor in the index */
+  if (g_sequence_iter_is_begin(iter) == TRUE) {
+    link->next = list->start;
+    if (list->start != NULL) {
+      list->start->prev = link;
+    }
+    list->start = link;
+  } else {
+    GList* prev = g_sequence_get(g_sequence_iter_prev(iter));
+    link->prev  = prev;
+    link->next  = prev->next;
+    if (prev->next != NULL) {
+      prev->next->prev = link;
+    }
+    prev->next = link;
+  }
+}
+
+static void
+sorted_list_rebuild_index(girara_list_t* list)
+{
+  g_sequence_remove_range(g_sequence_get_begin_iter(list->index),
+      g_sequence_get_end_iter(list->index));
+
+  for (GList* link = list->start; link != NULL; link = link->next) {
+    g_sequence_append(list->index, link);
+  }
+}
+
+/* Insert a detached chain of links into a sorted list: the chain is sorted
+ * once and merged with the existing elements. */
+static void
+sorted_list_insert_links(girara_list_t* list, GList* links)
+{
+  links = g_list_sort(links, list->cmp);
+
+  GList* head    = NULL;
+  GList* tail    = NULL;
+  GList* current = list->start;
+  while (current != NULL || links != NULL) {
+    GList* next = NULL;
+    if (links == NULL || (current != NULL && list->cmp(current->data, links->data) <= 0)) {
+      next    = current;
+      current = current->next;
+    } else {
+      next  = links;
+      links = links->next;
+    }
+
+    next->prev = tail;
+    next->next = NULL;
+    if (tail != NULL) {
+      tail->next = next;
+    } else {
+      head = next;
+    }
+    tail = next;
+  }
+
+  list->start = head;
+  sorted_list_rebuild_index(list);
+}
 
 girara_list_t*
 girara_list_new(void)
@@ -52,13 +158,7 @@ girara_list_new2(girara_free_function_t gfree)
 girara_list_t*
 girara_sorted_list_new(girara_compare_function_t cmp)
 {
-  girara_list_t* list = girara_list_new();
-  if (list == NULL) {
-    return NULL;
-  }
-
-  list->cmp = cmp;
-  return list;
+  return girara_sorted_list_new2(cmp, NULL);
 }
 
 girara_list_t*
@@ -70,6 +170,10 @@ girara_sorted_list_new2(girara_compare_function_t cmp, girara_free_function_t gf
   }
 
   list->cmp = cmp;
+  if (cmp != NULL) {
+    list->index = g_sequence_new(NULL);
+  }
+
   return list;
 }
 
@@ -93,6 +197,11 @@ girara_list_clear(girara_list_t* list)
     g_list_free(list->start);
   }
   list->start = NULL;
+
+  if (list->index != NULL) {
+    g_sequence_remove_range(g_sequence_get_begin_iter(list->index),
+        g_sequence_get_end_iter(list->index));
+  }
 }
 
 void
@@ -103,6 +212,9 @@ girara_list_free(girara_list_t* list)
   }
 
   girara_list_clear(list);
+  if (list->index != NULL) {
+    g_sequence_free(list->index);
+  }
   g_free(list);
 }
 
@@ -111,13 +223,31 @@ girara_list_append(girara_list_t* list, void* data)
 {
   g_return_if_fail(list != NULL);
 
-  if (list->cmp != NULL) {
-    list->start = g_list_insert_sorted(list->start, data, list->cmp);
+  if (list->index != NULL) {
+    sorted_list_insert(list, data);
   } else {
     list->start = g_list_append(list->start, data);
   }
 }
 
+void
+girara_list_append_array(girara_list_t* list, void** data, size_t n)
+{
+  g_return_if_fail(list != NULL);
+  g_return_if_fail(data != NULL || n == 0);
+
+  GList* links = NULL;
+  for (size_t i = n; i != 0; --i) {
+    links = g_list_prepend(links, data[i - 1]);
+  }
+
+  if (list->index != NULL) {
+    sorted_list_insert_links(list, links);
+  } else {
+    list->start = g_list_concat(list->start, links);
+  }
+}
+
 void
 girara_list_prepend(girara_list_t* list, void* data)
 {
@@ -138,9 +268,19 @@ girara_list_remove(girara_list_t* list, void* data)
     return;
   }
 
-  GList* tmp = g_list_find(list->start, data);
-  if (tmp == NULL) {
-    return;
+  GList* tmp = NULL;
+  if (list->index != NULL) {
+    GSequenceIter* iter = sorted_list_lookup(list, data, NULL);
+    if (iter == NULL) {
+      return;
+    }
+    tmp = g_sequence_get(iter);
+    g_sequence_remove(iter);
+  } else {
+    tmp = g_list_find(list->start, data);
+    if (tmp == NULL) {
+      return;
+    }
   }
 
   if (list->free != NULL) {
@@ -153,6 +293,12 @@ void*
 girara_list_nth(girara_list_t* list, size_t n)
 {
   g_return_val_if_fail(list != NULL, NULL);
+
+  if (list->index != NULL) {
+    g_return_val_if_fail(n < (size_t) g_sequence_get_length(list->index), NULL);
+    return ((GList*) g_sequence_get(g_sequence_get_iter_at_pos(list->index, n)))->data;
+  }
+
   g_return_val_if_fail(list->start != NULL && (n < g_list_length(list->start)), NULL);
 
   GList* tmp = g_list_nth(list->start, n);
@@ -169,6 +315,10 @@ girara_list_contains(girara_list_t* list, void* data)
     return false;
   }
 
+  if (list->index != NULL) {
+    return sorted_list_lookup(list, data, NULL) != NULL;
+  }
+
   GList* tmp = g_list_find(list->start, data);
   if (tmp == NULL) {
     return false;
@@ -214,6 +364,17 @@ girara_list_iterator(girara_list_t* list)
   return iter;
 }
 
+girara_list_iterator_t*
+girara_list_iterator_init(girara_list_iterator_t* iter, girara_list_t* list)
+{
+  g_return_val_if_fail(iter != NULL, NULL);
+
+  iter->list    = list;
+  iter->element = list != NULL ? list->start : NULL;
+
+  return iter;
+}
+
 girara_list_iterator_t*
 girara_list_iterator_copy(girara_list_iterator_t* iter)
 {
@@ -286,8 +447,15 @@ girara_list_iterator_remove(girara_list_iterator_t* iter) {
   }
 
   GList* el = iter->element;
+  if (iter->list != NULL && iter->list->index != NULL) {
+    GSequenceIter* index_iter = sorted_list_lookup(iter->list, el->data, el);
+    if (index_iter != NULL) {
+      g_sequence_remove(index_iter);
+    }
+  }
+
   if (iter->list != NULL && iter->list->free != NULL) {
-    (iter->list->free)(iter->element->data);
+    (iter->list->free)(el->data);
   }
 
   iter->element     = el->next;
@@ -305,7 +473,7 @@ girara_list_iterator_data(girara_list_iterator_t* iter)
 {
   g_return_val_if_fail(girara_list_iterator_is_valid(iter), NULL);
 
-  return iter->element->data;
+  return ((GList*) iter->element)->data;
 }
 
 void
@@ -314,11 +482,12 @@ girara_list_iterator_set(girara_list_iterator_t* iter, void *data)
   g_return_if_fail(girara_list_iterator_is_valid(iter));
   g_return_if_fail(iter->list->cmp == NULL);
 
+  GList* el = iter->element;
   if (iter->list->free != NULL) {
-    (*iter->list->free)(iter->element->data);
+    (*iter->list->free)(el->data);
   }
 
-  iter->element->data = data;
+  el->data = data;
 }
 
 void
@@ -340,6 +509,10 @@ girara_list_size(girara_list_t* list)
     return 0;
   }
 
+  if (list->index != NULL) {
+    return g_sequence_get_length(list->index);
+  }
+
   return g_list_length(list->start);
 }
 
@@ -352,14 +525,18 @@ girara_list_position(girara_list_t* list, void* data)
     return -1;
   }
 
+  if (list->index != NULL) {
+    GSequenceIter* iter = sorted_list_lookup(list, data, NULL);
+    return iter != NULL ? g_sequence_iter_get_position(iter) : -1;
+  }
+
   size_t pos = 0;
-  GIRARA_LIST_FOREACH(list, void*, iter, tmp)
+  GIRARA_LIST_FOREACH_STACK(list, void*, iter, tmp)
     if (tmp == data) {
-      girara_list_iterator_free(iter);
       return pos;
     }
     ++pos;
-  GIRARA_LIST_FOREACH_END(list, void*, iter, tmp);
+  GIRARA_LIST_FOREACH_STACK_END(list, void*, iter, tmp);
 
   return -1;
 }
@@ -373,6 +550,12 @@ girara_list_sort(girara_list_t* list, girara_compare_function_t compare)
   }
 
   list->start = g_list_sort(list->start, compare);
+
+  /* sorting a sorted list changes its order */
+  if (list->index != NULL) {
+    list->cmp = compare;
+    sorted_list_rebuild_index(list);
+  }
 }
 
 void
@@ -398,36 +581,284 @@ girara_list_merge(girara_list_t* list, girara_list_t* other)
   }
   other->free = NULL;
 
-  GIRARA_LIST_FOREACH(other, void*, iter, data)
+  if (list->index != NULL) {
+    /* sort the new elements once instead of inserting them one by one */
+    sorted_list_insert_links(list, g_list_copy(other->start));
+    return list;
+  }
+
+  GIRARA_LIST_FOREACH_STACK(other, void*, iter, data)
     girara_list_append(list, data);
-  GIRARA_LIST_FOREACH_END(other, void*, iter, data);
+  GIRARA_LIST_FOREACH_STACK_END(other, void*, iter, data);
   return list;
 }
 
-girara_tree_node_t*
-girara_node_new(void* data)
+struct girara_map_s
 {
-  girara_tree_node_t* node = g_try_malloc0(sizeof(girara_tree_node_t));
-  if (node == NULL) {
+  girara_free_function_t free; /**> The free function for the values */
+  GHashTable* table; /**> The hash table */
+  bool integer_keys; /**> Keys are integers instead of strings */
+};
+
+/* the iteration state of girara_map_iterator_t has to hold a GHashTableIter */
+typedef char girara_map_iterator_state_check[
+  sizeof(GHashTableIter) <= sizeof(((girara_map_iterator_t*) NULL)->state) ? 1 : -1];
+
+static girara_map_t*
+map_new(bool integer_keys, girara_free_function_t gfree)
+{
+  girara_map_t* map = g_try_malloc0(sizeof(girara_map_t));
+  if (map == NULL) {
     return NULL;
   }
 
-  girara_tree_node_data_t* nodedata = g_try_malloc0(sizeof(girara_tree_node_data_t));
-  if (nodedata == NULL) {
-    g_free(node);
-    return NULL;
+  if (integer_keys == true) {
+    map->table = g_hash_table_new(g_direct_hash, g_direct_equal);
+  } else {
+    map->table = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  }
+  map->integer_keys = integer_keys;
+  map->free         = gfree;
+
+  return map;
+}
+
+girara_map_t*
+girara_map_new(void)
+{
+  return map_new(false, NULL);
+}
+
+girara_map_t*
+girara_map_new2(girara_free_function_t gfree)
+{
+  return map_new(false, gfree);
+}
+
+girara_map_t*
+girara_int_map_new(void)
+{
+  return map_new(true, NULL);
+}
+
+girara_map_t*
+girara_int_map_new2(girara_free_function_t gfree)
+{
+  return map_new(true, gfree);
+}
+
+void
+girara_map_set_free_function(girara_map_t* map, girara_free_function_t gfree)
+{
+  g_return_if_fail(map);
+  map->free = gfree;
+}
+
+void
+girara_map_clear(girara_map_t* map)
+{
+  if (map == NULL) {
+    return;
+  }
+
+  if (map->free != NULL) {
+    GHashTableIter iter;
+    void* value = NULL;
+    g_hash_table_iter_init(&iter, map->table);
+    while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE) {
+      (*map->free)(value);
+    }
+  }
+
+  g_hash_table_remove_all(map->table);
+}
+
+void
+girara_map_free(girara_map_t* map)
+{
+  if (map == NULL) {
+    return;
+  }
+
+  girara_map_clear(map);
+  g_hash_table_unref(map->table);
+  g_free(map);
+}
+
+size_t
+girara_map_size(girara_map_t* map)
+{
+  g_return_val_if_fail(map, 0);
+
+  return g_hash_table_size(map->table);
+}
+
+static void
+map_insert(girara_map_t* map, void* key, void* value)
+{
+  void* old = NULL;
+  if (g_hash_table_lookup_extended(map->table, key, NULL, &old) == TRUE &&
+      old != value && map->free != NULL) {
+    (*map->free)(old);
+  }
+
+  g_hash_table_insert(map->table,
+      map->integer_keys == true ? key : g_strdup(key), value);
+}
+
+static bool
+map_remove(girara_map_t* map, const void* key)
+{
+  void* old = NULL;
+  if (g_hash_table_lookup_extended(map->table, key, NULL, &old) == FALSE) {
+    return false;
+  }
+
+  g_hash_table_remove(map->table, key);
+  if (map->free != NULL) {
+    (*map->free)(old);
+  }
+
+  return true;
+}
+
+bool
+girara_map_set(girara_map_t* map, const char* key, void* value)
+{
+  g_return_val_if_fail(map != NULL && map->integer_keys == false, false);
+  g_return_val_if_fail(key != NULL, false);
+
+  map_insert(map, (void*) key, value);
+  return true;
+}
+
+void*
+girara_map_get(girara_map_t* map, const char* key)
+{
+  g_return_val_if_fail(map != NULL && map->integer_keys == false, NULL);
+  g_return_val_if_fail(key != NULL, NULL);
+
+  return g_hash_table_lookup(map->table, key);
+}
+
+bool
+girara_map_contains(girara_map_t* map, const char* key)
+{
+  g_return_val_if_fail(map != NULL && map->integer_keys == false, false);
+  g_return_val_if_fail(key != NULL, false);
+
+  return g_hash_table_lookup_extended(map->table, key, NULL, NULL);
+}
+
+bool
+girara_map_remove(girara_map_t* map, const char* key)
+{
+  g_return_val_if_fail(map != NULL && map->integer_keys == false, false);
+  g_return_val_if_fail(key != NULL, false);
+
+  return map_remove(map, key);
+}
+
+bool
+girara_int_map_set(girara_map_t* map, intptr_t key, void* value)
+{
+  g_return_val_if_fail(map != NULL && map->integer_keys == true, false);
+
+  map_insert(map, (void*) key, value);
+  return true;
+}
+
+void*
+girara_int_map_get(girara_map_t* map, intptr_t key)
+{
+  g_return_val_if_fail(map != NULL && map->integer_keys == true, NULL);
+
+  return g_hash_table_lookup(map->table, (void*) key);
+}
+
+bool
+girara_int_map_contains(girara_map_t* map, intptr_t key)
+{
+  g_return_val_if_fail(map != NULL && map->integer_keys == true, false);
+
+  return g_hash_table_lookup_extended(map->table, (void*) key, NULL, NULL);
+}
+
+bool
+girara_int_map_remove(girara_map_t* map, intptr_t key)
+{
+  g_return_val_if_fail(map != NULL && map->integer_keys == true, false);
+
+  return map_remove(map, (void*) key);
+}
+
+girara_map_iterator_t*
+girara_map_iterator_init(girara_map_iterator_t* iter, girara_map_t* map)
+{
+  g_return_val_if_fail(iter != NULL, NULL);
+
+  iter->map   = map;
+  iter->key   = NULL;
+  iter->value = NULL;
+  if (map != NULL) {
+    g_hash_table_iter_init((GHashTableIter*) iter->state, map->table);
+  }
+
+  return iter;
+}
+
+bool
+girara_map_iterator_next(girara_map_iterator_t* iter)
+{
+  if (iter == NULL || iter->map == NULL) {
+    return false;
+  }
+
+  if (g_hash_table_iter_next((GHashTableIter*) iter->state, &iter->key,
+        &iter->value) == FALSE) {
+    iter->map = NULL;
+    return false;
   }
 
-  nodedata->data = data;
-  nodedata->node = node;
-  node->node     = g_node_new(nodedata);
+  return true;
+}
+
+const char*
+girara_map_iterator_key(girara_map_iterator_t* iter)
+{
+  g_return_val_if_fail(iter != NULL && iter->map != NULL, NULL);
+  g_return_val_if_fail(iter->map->integer_keys == false, NULL);
+
+  return iter->key;
+}
+
+intptr_t
+girara_map_iterator_int_key(girara_map_iterator_t* iter)
+{
+  g_return_val_if_fail(iter != NULL && iter->map != NULL, 0);
+  g_return_val_if_fail(iter->map->integer_keys == true, 0);
+
+  return (intptr_t) iter->key;
+}
+
+void*
+girara_map_iterator_value(girara_map_iterator_t* iter)
+{
+  g_return_val_if_fail(iter != NULL && iter->map != NULL, NULL);
+
+  return iter->value;
+}
 
-  if (node->node == NULL) {
-    g_free(node);
-    g_free(nodedata);
+girara_tree_node_t*
+girara_node_new(void* data)
+{
+  girara_tree_node_t* node = g_try_malloc0(sizeof(girara_tree_node_t));
+  if (node == NULL) {
     return NULL;
   }
 
+  node->data = data;
+
   return node;
 }
 
@@ -439,38 +870,120 @@ girara_node_set_free_function(girara_tree_node_t* node, girara_free_function_t g
 }
 
 void
-girara_node_free(girara_tree_node_t* node)
+girara_node_set_loader(girara_tree_node_t* node,
+    girara_node_loader_function_t loader, void* data)
 {
-  if (node == NULL) {
+  g_return_if_fail(node);
+
+  node->loader      = loader;
+  node->loader_data = data;
+  node->loaded      = false;
+}
+
+bool
+girara_node_is_loaded(girara_tree_node_t* node)
+{
+  g_return_val_if_fail(node, false);
+
+  return node->loader == NULL || node->loaded == true;
+}
+
+static void
+node_load(girara_tree_node_t* node)
+{
+  if (node->loader == NULL || node->loaded == true) {
     return;
   }
 
-  g_return_if_fail(node->node);
-  girara_tree_node_data_t* nodedata = (girara_tree_node_data_t*) node->node->data;
-  g_return_if_fail(nodedata);
+  /* mark as loaded first, the loader appends to this node */
+  node->loaded = true;
+  node->loader(node, node->loader_data);
+}
 
-  if (node->free != NULL) {
-    (*node->free)(nodedata->data);
+static void
+node_unlink(girara_tree_node_t* node)
+{
+  girara_tree_node_t* parent = node->parent;
+  if (parent == NULL) {
+    return;
   }
 
-  g_free(nodedata);
+  for (size_t i = node->index + 1; i < parent->num_children; ++i) {
+    parent->children[i - 1] = parent->children[i];
+    parent->children[i - 1]->index = i - 1;
+  }
+  --parent->num_children;
+
+  node->parent = NULL;
+  node->index  = 0;
+}
+
+/* frees the data of node and its descendants in depth-first order; the tree
+ * is walked through the parent links, so deep trees do not exhaust the stack */
+static void
+node_free_tree(girara_tree_node_t* node)
+{
+  girara_tree_node_t* current = node;
+  while (current != NULL) {
+    if (current->free != NULL) {
+      (*current->free)(current->data);
+    }
+
+    if (current->num_children != 0) {
+      current = current->children[0];
+      continue;
+    }
+
+    /* release nodes whose subtrees are done until there is a sibling left */
+    girara_tree_node_t* next = NULL;
+    while (next == NULL) {
+      girara_tree_node_t* parent = current == node ? NULL : current->parent;
+      const size_t index         = current->index;
+      g_free(current->children);
+      g_free(current);
+
+      if (parent == NULL) {
+        break;
+      }
+
+      if (index + 1 < parent->num_children) {
+        next = parent->children[index + 1];
+      } else {
+        current = parent;
+      }
+    }
+    current = next;
+  }
+}
 
-  GNode* childnode = node->node->children;
-  while (childnode != NULL) {
-    girara_tree_node_data_t* nodedata = (girara_tree_node_data_t*) childnode->data;
-    girara_node_free(nodedata->node);
-    childnode = childnode->next;
+void
+girara_node_free(girara_tree_node_t* node)
+{
+  if (node == NULL) {
+    return;
   }
 
-  g_node_destroy(node->node);
-  g_free(node);
+  node_unlink(node);
+  node_free_tree(node);
 }
 
 void
 girara_node_append(girara_tree_node_t* parent, girara_tree_node_t* child)
 {
   g_return_if_fail(parent && child);
-  g_node_append(parent->node, child->node);
+  g_return_if_fail(child->parent == NULL);
+
+  if (parent->num_children == parent->capacity) {
+    /* the caller hands over the child, so growing the array must not fail */
+    const size_t capacity = parent->capacity == 0 ? 4 : 2 * parent->capacity;
+    parent->children = g_realloc(parent->children,
+        capacity * sizeof(girara_tree_node_t*));
+    parent->capacity = capacity;
+  }
+
+  child->parent = parent;
+  child->index  = parent->num_children;
+  parent->children[parent->num_children++] = child;
 }
 
 girara_tree_node_t*
@@ -479,7 +992,9 @@ girara_node_append_data(girara_tree_node_t* parent, void* data)
   g_return_val_if_fail(parent, NULL);
   girara_tree_node_t* child = girara_node_new(data);
   g_return_val_if_fail(child, NULL);
-  child->free = parent->free;
+  child->free        = parent->free;
+  child->loader      = parent->loader;
+  child->loader_data = parent->loader_data;
   girara_node_append(parent, child);
 
   return child;
@@ -488,33 +1003,21 @@ girara_node_append_data(girara_tree_node_t* parent, void* data)
 girara_tree_node_t*
 girara_node_get_parent(girara_tree_node_t* node)
 {
-  g_return_val_if_fail(node && node->node, NULL);
-
-  if (node->node->parent == NULL) {
-    return NULL;
-  }
-
-  girara_tree_node_data_t* nodedata = (girara_tree_node_data_t*) node->node->parent->data;
-  g_return_val_if_fail(nodedata, NULL);
+  g_return_val_if_fail(node, NULL);
 
-  return nodedata->node;
+  return node->parent;
 }
 
 girara_tree_node_t*
 girara_node_get_root(girara_tree_node_t* node)
 {
-  g_return_val_if_fail(node && node->node, NULL);
+  g_return_val_if_fail(node, NULL);
 
-  if (node->node->parent == NULL) {
-    return node;
+  while (node->parent != NULL) {
+    node = node->parent;
   }
 
-  GNode* root = g_node_get_root(node->node);
-  g_return_val_if_fail(root, NULL);
-  girara_tree_node_data_t* nodedata = (girara_tree_node_data_t*) root->data;
-  g_return_val_if_fail(nodedata, NULL);
-
-  return nodedata->node;
+  return node;
 }
 
 girara_list_t*
@@ -524,11 +1027,9 @@ girara_node_get_children(girara_tree_node_t* node)
   girara_list_t* list = girara_list_new();
   g_return_val_if_fail(list, NULL);
 
-  GNode* childnode = node->node->children;
-  while (childnode != NULL) {
-    girara_tree_node_data_t* nodedata = (girara_tree_node_data_t*) childnode->data;
-    girara_list_append(list, nodedata->node);
-    childnode = childnode->next;
+  node_load(node);
+  for (size_t i = 0; i != node->num_children; ++i) {
+    girara_list_append(list, node->children[i]);
   }
 
   return list;
@@ -537,31 +1038,134 @@ girara_node_get_children(girara_tree_node_t* node)
 size_t
 girara_node_get_num_children(girara_tree_node_t* node)
 {
-  g_return_val_if_fail(node && node->node, 0);
+  g_return_val_if_fail(node, 0);
+
+  node_load(node);
+  return node->num_children;
+}
+
+girara_tree_node_t*
+girara_node_get_child(girara_tree_node_t* node, size_t n)
+{
+  g_return_val_if_fail(node, NULL);
+
+  node_load(node);
+  g_return_val_if_fail(n < node->num_children, NULL);
+
+  return node->children[n];
+}
+
+girara_tree_node_t*
+girara_node_get_next_sibling(girara_tree_node_t* node)
+{
+  g_return_val_if_fail(node, NULL);
+
+  girara_tree_node_t* parent = node->parent;
+  if (parent == NULL || node->index + 1 >= parent->num_children) {
+    return NULL;
+  }
+
+  return parent->children[node->index + 1];
+}
+
+girara_tree_node_t*
+girara_node_dfs_next(girara_tree_node_t* root, girara_tree_node_t* node)
+{
+  g_return_val_if_fail(root && node, NULL);
+
+  node_load(node);
+  if (node->num_children != 0) {
+    return node->children[0];
+  }
+
+  /* climb up until there is an unvisited sibling */
+  while (node != root && node->parent != NULL) {
+    girara_tree_node_t* sibling = girara_node_get_next_sibling(node);
+    if (sibling != NULL) {
+      return sibling;
+    }
+    node = node->parent;
+  }
+
+  return NULL;
+}
+
+/* leftmost descendant of node depth levels below it; the subtree is walked
+ * through the parent links, so no stack is needed */
+static girara_tree_node_t*
+node_first_at_depth(girara_tree_node_t* node, size_t depth)
+{
+  girara_tree_node_t* current = node;
+  size_t level = 0;
+
+  while (level != depth) {
+    node_load(current);
+    if (current->num_children != 0) {
+      current = current->children[0];
+      ++level;
+      continue;
+    }
+
+    /* climb up until there is a sibling that has not been visited */
+    girara_tree_node_t* sibling = NULL;
+    while (sibling == NULL && current != node) {
+      sibling = girara_node_get_next_sibling(current);
+      if (sibling == NULL) {
+        current = current->parent;
+        --level;
+      }
+    }
+
+    if (sibling == NULL) {
+      return NULL;
+    }
+    current = sibling;
+  }
+
+  return current;
+}
+
+girara_tree_node_t*
+girara_node_bfs_next(girara_tree_node_t* root, girara_tree_node_t* node)
+{
+  g_return_val_if_fail(root && node, NULL);
+
+  /* look for the next node on the same level ... */
+  size_t depth = 0;
+  girara_tree_node_t* current = node;
+  while (current != root && current->parent != NULL) {
+    girara_tree_node_t* parent = current->parent;
+    for (size_t i = current->index + 1; i < parent->num_children; ++i) {
+      girara_tree_node_t* result = node_first_at_depth(parent->children[i], depth);
+      if (result != NULL) {
+        return result;
+      }
+    }
+
+    current = parent;
+    ++depth;
+  }
 
-  return g_node_n_children(node->node);
+  /* ... or continue with the first node of the next level */
+  return node_first_at_depth(root, depth + 1);
 }
 
 void*
 girara_node_get_data(girara_tree_node_t* node)
 {
-  g_return_val_if_fail(node && node->node, NULL);
-  girara_tree_node_data_t* nodedata = (girara_tree_node_data_t*) node->node->data;
-  g_return_val_if_fail(nodedata, NULL);
+  g_return_val_if_fail(node, NULL);
 
-  return nodedata->data;
+  return node->data;
 }
 
 void
 girara_node_set_data(girara_tree_node_t* node, void* data)
 {
-  g_return_if_fail(node && node->node);
-  girara_tree_node_data_t* nodedata = (girara_tree_node_data_t*) node->node->data;
-  g_return_if_fail(nodedata);
+  g_return_if_fail(node);
 
   if (node->free != NULL) {
-    (*node->free)(nodedata->data);
+    (*node->free)(node->data);
   }
 
-  nodedata->data = data;
+  node->data = data;
 }
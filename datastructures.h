@@ -5,9 +5,21 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <sys/types.h>
 #include "types.h"
 
+/**
+ * List iterator. The layout is only exposed to allow iterators to be placed on
+ * the stack with @ref girara_list_iterator_init; the members must not be
+ * accessed directly.
+ */
+struct girara_list_iterator_s
+{
+  girara_list_t* list; /**> The list */
+  void* element; /**> The current element */
+};
+
 /**
  * Create a new list.
  *
@@ -24,7 +36,13 @@ girara_list_t* girara_list_new(void);
 girara_list_t* girara_list_new2(girara_free_function_t gfree);
 
 /**
- * Create a new (sorted) list.
+ * Create a new (sorted) list. Sorted lists keep a balanced index of their
+ * elements, so inserting, removing and looking up elements as well as
+ * determining their position takes logarithmic time. Lookups use the compare
+ * function, hence elements must not be modified in a way that changes their
+ * order while they are stored in the list. Elements comparing equal keep
+ * their insertion order, i.e. a new element is placed after the elements it
+ * compares equal to.
  *
  * @param cmp Pointer to the compare function.
  * @return The girara list object or NULL if an error occured.
@@ -73,6 +91,17 @@ void girara_list_free(girara_list_t* list);
  */
 void girara_list_append(girara_list_t* list, void* data);
 
+/**
+ * Append several elements to the list. For sorted lists the new elements are
+ * sorted once and merged into the list, which is considerably faster than
+ * appending them one at a time.
+ *
+ * @param list The girara list object
+ * @param data Array of elements
+ * @param n Number of elements in data
+ */
+void girara_list_append_array(girara_list_t* list, void** data, size_t n);
+
 /**
  * Prepend an element to the list.
  *
@@ -151,6 +180,18 @@ void* girara_list_find(girara_list_t* list, girara_compare_function_t compare,
  */
 girara_list_iterator_t* girara_list_iterator(girara_list_t* list);
 
+/**
+ * Initialize a caller provided iterator, e.g. one on the stack, to point at
+ * the start of list. Such an iterator must not be passed to
+ * @ref girara_list_iterator_free.
+ *
+ * @param iter The iterator to initialize
+ * @param list The girara list object
+ * @return iter or NULL if an error occured
+ */
+girara_list_iterator_t* girara_list_iterator_init(girara_list_iterator_t* iter,
+    girara_list_t* list);
+
 /**
  * Create an iterator pointing to the same element as iter.
  *
@@ -253,6 +294,23 @@ void girara_list_foreach(girara_list_t* list, girara_list_callback_t callback,
     girara_list_iterator_free(iter); \
   } while(0)
 
+/**
+ * Like GIRARA_LIST_FOREACH, but the iterator lives on the stack. Hence no
+ * memory is allocated and the loop can be left early without calling
+ * @ref girara_list_iterator_free.
+ */
+#define GIRARA_LIST_FOREACH_STACK(list, type, iter, data) \
+  do { \
+    girara_list_iterator_t iter ## _storage; \
+    girara_list_iterator_t* iter = girara_list_iterator_init(&iter ## _storage, list); \
+    while (girara_list_iterator_is_valid(iter)) { \
+      type data = (type)girara_list_iterator_data(iter);
+
+#define GIRARA_LIST_FOREACH_STACK_END(list, type, iter, data) \
+      girara_list_iterator_next(iter); \
+    } \
+  } while(0)
+
 /**
  * Merge a list into another one. Both lists need to have the same free
  * function. If other has a source free function set it will be set to NULL as
@@ -263,6 +321,209 @@ void girara_list_foreach(girara_list_t* list, girara_list_callback_t callback,
  */
 girara_list_t* girara_list_merge(girara_list_t* list, girara_list_t* other);
 
+/**
+ * Map iterator. The layout is only exposed to allow iterators to be placed on
+ * the stack with @ref girara_map_iterator_init; the members must not be
+ * accessed directly.
+ */
+struct girara_map_iterator_s
+{
+  girara_map_t* map; /**> The map */
+  void* key; /**> The current key */
+  void* value; /**> The current value */
+  void* state[6]; /**> Iteration state */
+};
+
+/**
+ * Create a new map with string keys. Keys are copied.
+ *
+ * @return The girara map object or NULL if an error occured
+ */
+girara_map_t* girara_map_new(void);
+
+/**
+ * Create a new map with string keys. Keys are copied.
+ *
+ * @param gfree Pointer to the free function for the values
+ * @return The girara map object or NULL if an error occured
+ */
+girara_map_t* girara_map_new2(girara_free_function_t gfree);
+
+/**
+ * Create a new map with integer keys.
+ *
+ * @return The girara map object or NULL if an error occured
+ */
+girara_map_t* girara_int_map_new(void);
+
+/**
+ * Create a new map with integer keys.
+ *
+ * @param gfree Pointer to the free function for the values
+ * @return The girara map object or NULL if an error occured
+ */
+girara_map_t* girara_int_map_new2(girara_free_function_t gfree);
+
+/**
+ * Set the function which should be called if a stored value should be freed.
+ *
+ * @param map The girara map object
+ * @param gfree Pointer to the free function
+ */
+void girara_map_set_free_function(girara_map_t* map,
+    girara_free_function_t gfree);
+
+/**
+ * Remove all entries from a map.
+ *
+ * @param map The girara map object
+ */
+void girara_map_clear(girara_map_t* map);
+
+/**
+ * Destroy map.
+ *
+ * @param map The girara map object
+ */
+void girara_map_free(girara_map_t* map);
+
+/**
+ * Get the number of entries in the map.
+ *
+ * @param map The girara map object
+ * @return The number of entries
+ */
+size_t girara_map_size(girara_map_t* map);
+
+/**
+ * Set the value stored for key. An existing value is replaced and freed.
+ *
+ * @param map The girara map object with string keys
+ * @param key The key
+ * @param value The value
+ * @return true if no error occured
+ */
+bool girara_map_set(girara_map_t* map, const char* key, void* value);
+
+/**
+ * Get the value stored for key.
+ *
+ * @param map The girara map object with string keys
+ * @param key The key
+ * @return The value or NULL if no value is stored for key
+ */
+void* girara_map_get(girara_map_t* map, const char* key);
+
+/**
+ * Check if the map contains a value for key.
+ *
+ * @param map The girara map object with string keys
+ * @param key The key
+ * @return true if the map contains key
+ */
+bool girara_map_contains(girara_map_t* map, const char* key);
+
+/**
+ * Remove and free the value stored for key.
+ *
+ * @param map The girara map object with string keys
+ * @param key The key
+ * @return true if an entry has been removed
+ */
+bool girara_map_remove(girara_map_t* map, const char* key);
+
+/**
+ * Set the value stored for key. An existing value is replaced and freed.
+ *
+ * @param map The girara map object with integer keys
+ * @param key The key
+ * @param value The value
+ * @return true if no error occured
+ */
+bool girara_int_map_set(girara_map_t* map, intptr_t key, void* value);
+
+/**
+ * Get the value stored for key.
+ *
+ * @param map The girara map object with integer keys
+ * @param key The key
+ * @return The value or NULL if no value is stored for key
+ */
+void* girara_int_map_get(girara_map_t* map, intptr_t key);
+
+/**
+ * Check if the map contains a value for key.
+ *
+ * @param map The girara map object with integer keys
+ * @param key The key
+ * @return true if the map contains key
+ */
+bool girara_int_map_contains(girara_map_t* map, intptr_t key);
+
+/**
+ * Remove and free the value stored for key.
+ *
+ * @param map The girara map object with integer keys
+ * @param key The key
+ * @return true if an entry has been removed
+ */
+bool girara_int_map_remove(girara_map_t* map, intptr_t key);
+
+/**
+ * Initialize a caller provided iterator, e.g. one on the stack. The iterator
+ * points before the first entry; call @ref girara_map_iterator_next to advance
+ * it. The map must not be modified while it is iterated.
+ *
+ * @param iter The iterator to initialize
+ * @param map The girara map object
+ * @return iter or NULL if an error occured
+ */
+girara_map_iterator_t* girara_map_iterator_init(girara_map_iterator_t* iter,
+    girara_map_t* map);
+
+/**
+ * Move iterator to the next entry.
+ *
+ * @param iter The map iterator
+ * @return true if the iterator points to an entry, false at the end
+ */
+bool girara_map_iterator_next(girara_map_iterator_t* iter);
+
+/**
+ * Get the key of the entry pointed to by the iterator.
+ *
+ * @param iter The iterator of a map with string keys
+ * @return The key
+ */
+const char* girara_map_iterator_key(girara_map_iterator_t* iter);
+
+/**
+ * Get the key of the entry pointed to by the iterator.
+ *
+ * @param iter The iterator of a map with integer keys
+ * @return The key
+ */
+intptr_t girara_map_iterator_int_key(girara_map_iterator_t* iter);
+
+/**
+ * Get the value of the entry pointed to by the iterator.
+ *
+ * @param iter The map iterator
+ * @return The value
+ */
+void* girara_map_iterator_value(girara_map_iterator_t* iter);
+
+#define GIRARA_MAP_FOREACH(map, type, iter, value) \
+  do { \
+    girara_map_iterator_t iter ## _storage; \
+    girara_map_iterator_t* iter = girara_map_iterator_init(&iter ## _storage, map); \
+    while (girara_map_iterator_next(iter)) { \
+      type value = (type)girara_map_iterator_value(iter);
+
+#define GIRARA_MAP_FOREACH_END(map, type, iter, value) \
+    } \
+  } while(0)
+
 /**
  * Create a new node.
  *
@@ -280,6 +541,27 @@ girara_tree_node_t* girara_node_new(void* data);
 void girara_node_set_free_function(girara_tree_node_t* node,
     girara_free_function_t gfree);
 
+/**
+ * Make the node lazy: its children are populated by calling loader the first
+ * time they are requested, i.e. by any function returning or traversing the
+ * children. Nodes created with @ref girara_node_append_data inherit the loader
+ * and are lazy themselves.
+ *
+ * @param node The girara node object
+ * @param loader The function appending the children to the node
+ * @param data User data passed to the loader
+ */
+void girara_node_set_loader(girara_tree_node_t* node,
+    girara_node_loader_function_t loader, void* data);
+
+/**
+ * Check if the children of a node are available without calling the loader.
+ *
+ * @param node The girara node object
+ * @return true if the node is not lazy or its loader has already been called
+ */
+bool girara_node_is_loaded(girara_tree_node_t* node);
+
 /**
  * Free a node. This will remove the node from its' parent and will destroy all
  * its' children.
@@ -289,7 +571,7 @@ void girara_node_set_free_function(girara_tree_node_t* node,
 void girara_node_free(girara_tree_node_t* node);
 
 /**
- * Append a node to another node.
+ * Append a node to another node. The parent takes ownership of the child.
  *
  * @param parent The parent node
  * @param child The child node
@@ -338,6 +620,60 @@ girara_list_t* girara_node_get_children(girara_tree_node_t* node);
  */
 size_t girara_node_get_num_children(girara_tree_node_t* node);
 
+/**
+ * Get the nth child.
+ *
+ * @param node The girara node object
+ * @param n Index of the child
+ * @return The child node or NULL if an error occured
+ */
+girara_tree_node_t* girara_node_get_child(girara_tree_node_t* node, size_t n);
+
+/**
+ * Get the next sibling.
+ *
+ * @param node The girara node object
+ * @return The next sibling or NULL if node is the last child
+ */
+girara_tree_node_t* girara_node_get_next_sibling(girara_tree_node_t* node);
+
+/**
+ * Get the node following node in a depth-first (pre-order) traversal of the
+ * tree starting at root. No memory is allocated.
+ *
+ * @param root The root of the traversed (sub)tree
+ * @param node The current node
+ * @return The next node or NULL if the traversal is finished
+ */
+girara_tree_node_t* girara_node_dfs_next(girara_tree_node_t* root,
+    girara_tree_node_t* node);
+
+/**
+ * Get the node following node in a breadth-first traversal of the tree
+ * starting at root. No memory is allocated. As no state is kept between the
+ * calls, finding the next node may have to walk the subtrees of the following
+ * siblings of node and its ancestors, so a single call takes O(n) and a
+ * complete traversal O(n²) time for a tree of n nodes in the worst case. Use
+ * girara_node_dfs_next, which takes amortized constant time per node, if the
+ * order does not matter.
+ *
+ * @param root The root of the traversed (sub)tree
+ * @param node The current node
+ * @return The next node or NULL if the traversal is finished
+ */
+girara_tree_node_t* girara_node_bfs_next(girara_tree_node_t* root,
+    girara_tree_node_t* node);
+
+#define GIRARA_NODE_FOREACH_CHILD(node, child) \
+  do { \
+    const size_t child ## _count = girara_node_get_num_children(node); \
+    for (size_t child ## _index = 0; child ## _index < child ## _count; ++child ## _index) { \
+      girara_tree_node_t* child = girara_node_get_child(node, child ## _index);
+
+#define GIRARA_NODE_FOREACH_CHILD_END(node, child) \
+    } \
+  } while(0)
+
 /**
  * Get data.
  *
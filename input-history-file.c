@@ -0,0 +1,303 @@
+/* See LICENSE file for license and copyright information */
+
+#define _BSD_SOURCE
+#define _DEFAULT_SOURCE
+#define _FILE_OFFSET_BITS 64
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "input-history.h"
+#include "datastructures.h"
+#include "macros.h"
+
+static void ih_file_io_init(GiraraInputHistoryIOInterface* iface);
+
+G_DEFINE_TYPE_WITH_CODE(GiraraInputHistoryFile, girara_input_history_file,
+    G_TYPE_OBJECT, G_IMPLEMENT_INTERFACE(GIRARA_TYPE_INPUT_HISTORY_IO,
+      ih_file_io_init))
+
+/**
+ * Private data of the file based input history
+ */
+typedef struct ih_file_private_s {
+  char* path; /**< Path of the history file */
+  off_t offset; /**< Offset up to which the file has been read */
+  dev_t device; /**< Device of the file read last */
+  ino_t inode; /**< Inode of the file read last */
+} ih_file_private_t;
+
+#define GIRARA_INPUT_HISTORY_FILE_GET_PRIVATE(obj) \
+  (G_TYPE_INSTANCE_GET_PRIVATE ((obj), GIRARA_TYPE_INPUT_HISTORY_FILE, \
+                                ih_file_private_t))
+
+/* Methods */
+static void ih_file_finalize(GObject* object);
+static void ih_file_set_property(GObject* object, guint prop_id,
+    const GValue* value, GParamSpec* pspec);
+static void ih_file_get_property(GObject* object, guint prop_id,
+    GValue* value, GParamSpec* pspec);
+static void ih_file_append(GiraraInputHistoryIO* io, const char* input);
+static girara_list_t* ih_file_read(GiraraInputHistoryIO* io);
+static girara_list_t* ih_file_tail(GiraraInputHistoryIO* io, bool* reload);
+
+/* Properties */
+enum {
+  PROP_0,
+  PROP_PATH
+};
+
+/* Class init */
+static void
+girara_input_history_file_class_init(GiraraInputHistoryFileClass* class)
+{
+  /* add private members */
+  g_type_class_add_private(class, sizeof(ih_file_private_t));
+
+  /* overwrite methods */
+  GObjectClass* object_class = G_OBJECT_CLASS(class);
+  object_class->finalize     = ih_file_finalize;
+  object_class->set_property = ih_file_set_property;
+  object_class->get_property = ih_file_get_property;
+
+  /* properties */
+  g_object_class_install_property(object_class, PROP_PATH,
+    g_param_spec_string("path", "path", "Path of the history file",
+      NULL,
+      G_PARAM_WRITABLE | G_PARAM_READABLE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+}
+
+/* Interface init */
+static void
+ih_file_io_init(GiraraInputHistoryIOInterface* iface)
+{
+  iface->append = ih_file_append;
+  iface->read   = ih_file_read;
+  iface->tail   = ih_file_tail;
+}
+
+/* Object init */
+static void
+girara_input_history_file_init(GiraraInputHistoryFile* file)
+{
+  ih_file_private_t* priv = GIRARA_INPUT_HISTORY_FILE_GET_PRIVATE(file);
+  priv->path   = NULL;
+  priv->offset = 0;
+  priv->device = 0;
+  priv->inode  = 0;
+}
+
+/* GObject finalize */
+static void
+ih_file_finalize(GObject* object)
+{
+  ih_file_private_t* priv = GIRARA_INPUT_HISTORY_FILE_GET_PRIVATE(object);
+  g_free(priv->path);
+
+  G_OBJECT_CLASS(girara_input_history_file_parent_class)->finalize(object);
+}
+
+/* GObject set_property */
+static void
+ih_file_set_property(GObject* object, guint prop_id, const GValue* value,
+    GParamSpec* pspec)
+{
+  ih_file_private_t* priv = GIRARA_INPUT_HISTORY_FILE_GET_PRIVATE(object);
+
+  switch (prop_id) {
+    case PROP_PATH:
+      g_free(priv->path);
+      priv->path = g_strdup(g_value_get_string(value));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+  }
+}
+
+/* GObject get_property */
+static void
+ih_file_get_property(GObject* object, guint prop_id, GValue* value,
+    GParamSpec* pspec)
+{
+  ih_file_private_t* priv = GIRARA_INPUT_HISTORY_FILE_GET_PRIVATE(object);
+
+  switch (prop_id) {
+    case PROP_PATH:
+      g_value_set_string(value, priv->path);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+  }
+}
+
+/* Object new */
+GiraraInputHistoryIO*
+girara_input_history_file_new(const char* path)
+{
+  g_return_val_if_fail(path != NULL, NULL);
+
+  return GIRARA_INPUT_HISTORY_IO(g_object_new(GIRARA_TYPE_INPUT_HISTORY_FILE,
+        "path", path, NULL));
+}
+
+/* Method implementions */
+
+static bool
+ih_file_lock(int fd, int operation)
+{
+  while (flock(fd, operation) != 0) {
+    if (errno != EINTR) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void
+ih_file_append(GiraraInputHistoryIO* io, const char* input)
+{
+  ih_file_private_t* priv = GIRARA_INPUT_HISTORY_FILE_GET_PRIVATE(io);
+  if (priv->path == NULL || input == NULL) {
+    return;
+  }
+
+  const int fd = open(priv->path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0600);
+  if (fd == -1) {
+    return;
+  }
+
+  if (ih_file_lock(fd, LOCK_EX) == false) {
+    close(fd);
+    return;
+  }
+
+  /* one entry per line: the whole entry is written with a single write so
+   * that readers never see a partial line while holding the lock */
+  char* line = g_strconcat(input, "\n", NULL);
+  g_strdelimit(line, "\n", ' ');
+  line[strlen(line) - 1] = '\n';
+
+  size_t length = strlen(line);
+  size_t written = 0;
+  while (written < length) {
+    const ssize_t res = write(fd, line + written, length - written);
+    if (res == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    written += res;
+  }
+
+  g_free(line);
+  ih_file_lock(fd, LOCK_UN);
+  close(fd);
+}
+
+static girara_list_t*
+ih_file_read_from(ih_file_private_t* priv, bool* reload)
+{
+  girara_list_t* list = girara_list_new2((girara_free_function_t) g_free);
+  if (list == NULL) {
+    return NULL;
+  }
+
+  const int fd = open(priv->path, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    /* the file has been removed; start over once it reappears */
+    *reload     = priv->offset != 0;
+    priv->offset = 0;
+    return list;
+  }
+
+  struct stat sb;
+  if (ih_file_lock(fd, LOCK_SH) == false || fstat(fd, &sb) != 0) {
+    close(fd);
+    return list;
+  }
+
+  /* read everything again if the file was replaced or truncated */
+  if (priv->offset == 0 || sb.st_dev != priv->device ||
+      sb.st_ino != priv->inode || sb.st_size < priv->offset) {
+    *reload      = true;
+    priv->offset = 0;
+    priv->device = sb.st_dev;
+    priv->inode  = sb.st_ino;
+  }
+
+  if (sb.st_size == priv->offset ||
+      lseek(fd, priv->offset, SEEK_SET) == (off_t) -1) {
+    ih_file_lock(fd, LOCK_UN);
+    close(fd);
+    return list;
+  }
+
+  const size_t size = sb.st_size - priv->offset;
+  char* content     = g_try_malloc(size + 1);
+  size_t nread      = 0;
+  while (content != NULL && nread < size) {
+    const ssize_t res = read(fd, content + nread, size - nread);
+    if (res == -1 && errno == EINTR) {
+      continue;
+    } else if (res <= 0) {
+      break;
+    }
+    nread += res;
+  }
+
+  ih_file_lock(fd, LOCK_UN);
+  close(fd);
+
+  if (content == NULL) {
+    return list;
+  }
+
+  /* only consume complete lines */
+  size_t consumed = 0;
+  for (size_t i = 0; i < nread; ++i) {
+    if (content[i] != '\n') {
+      continue;
+    }
+
+    if (i > consumed) {
+      girara_list_append(list, g_strndup(content + consumed, i - consumed));
+    }
+    consumed = i + 1;
+  }
+
+  priv->offset += consumed;
+  g_free(content);
+
+  return list;
+}
+
+static girara_list_t*
+ih_file_read(GiraraInputHistoryIO* io)
+{
+  ih_file_private_t* priv = GIRARA_INPUT_HISTORY_FILE_GET_PRIVATE(io);
+  if (priv->path == NULL) {
+    return NULL;
+  }
+
+  bool reload  = false;
+  priv->offset = 0;
+  return ih_file_read_from(priv, &reload);
+}
+
+static girara_list_t*
+ih_file_tail(GiraraInputHistoryIO* io, bool* reload)
+{
+  ih_file_private_t* priv = GIRARA_INPUT_HISTORY_FILE_GET_PRIVATE(io);
+  if (priv->path == NULL) {
+    return NULL;
+  }
+
+  return ih_file_read_from(priv, reload);
+}
@@ -22,3 +22,19 @@ girara_list_t* girara_input_history_io_read(GiraraInputHistoryIO* io)
   g_return_val_if_fail(GIRARA_IS_INPUT_HISTORY_IO(io) == true, NULL);
   return GIRARA_INPUT_HISTORY_IO_GET_INTERFACE(io)->read(io);
 }
+
+girara_list_t* girara_input_history_io_tail(GiraraInputHistoryIO* io,
+    bool* reload)
+{
+  g_return_val_if_fail(GIRARA_IS_INPUT_HISTORY_IO(io) == true, NULL);
+  g_return_val_if_fail(reload != NULL, NULL);
+
+  GiraraInputHistoryIOInterface* iface = GIRARA_INPUT_HISTORY_IO_GET_INTERFACE(io);
+  if (iface->tail == NULL) {
+    *reload = true;
+    return iface->read(io);
+  }
+
+  *reload = false;
+  return iface->tail(io, reload);
+}
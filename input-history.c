@@ -285,11 +285,23 @@ ih_reset(GiraraInputHistory* history)
     if (list == NULL) {
       return;
     }
-    girara_list_clear(list);
 
-    girara_list_t* newlist = girara_input_history_io_read(priv->io);
+    /* only ingest the inputs added since the last read, unless the storage
+     * asks for a full reload */
+    bool reload = false;
+    girara_list_t* newlist = girara_input_history_io_tail(priv->io, &reload);
+    if (reload == true) {
+      girara_list_clear(list);
+    }
+
     if (newlist != NULL) {
       GIRARA_LIST_FOREACH(newlist, const char*, iter, data)
+        if (reload == false) {
+          void* old = NULL;
+          while ((old = girara_list_find(list, (girara_compare_function_t) g_strcmp0, data)) != NULL) {
+            girara_list_remove(list, old);
+          }
+        }
         girara_list_append(list, g_strdup(data));
       GIRARA_LIST_FOREACH_END(newlist, const char*, iter, data);
       girara_list_free(newlist);
@@ -27,8 +27,19 @@ struct girara_input_history_io_interface_s {
    */
   girara_list_t* (*read)(GiraraInputHistoryIO* io);
 
+  /**
+   * Read the items that were added to the input history storage since the
+   * last call to read or tail, e.g. by other processes sharing the same
+   * storage. If the storage was replaced or truncated in the meantime, all
+   * items are returned and reload is set to true. This method is optional.
+   *
+   * @param io a GiraraInputHistoryIO object
+   * @param reload set to true if the returned list contains all items
+   * @returns a list of inputs
+   */
+  girara_list_t* (*tail)(GiraraInputHistoryIO* io, bool* reload);
+
   /* reserved for further methods */
-  void (*reserved1)(void);
   void (*reserved2)(void);
   void (*reserved3)(void);
   void (*reserved4)(void);
@@ -49,6 +60,51 @@ void girara_input_history_io_append(GiraraInputHistoryIO* io, const char* input)
 
 girara_list_t* girara_input_history_io_read(GiraraInputHistoryIO* io);
 
+/**
+ * Read the items that were added to the input history storage since the last
+ * read. If the io object does not implement incremental reads, all items are
+ * read and reload is set to true.
+ *
+ * @param io a GiraraInputHistoryIO object
+ * @param reload set to true if the returned list contains all items
+ * @returns a list of inputs
+ */
+girara_list_t* girara_input_history_io_tail(GiraraInputHistoryIO* io,
+    bool* reload);
+
+struct girara_input_history_file_s {
+  GObject parent;
+};
+
+struct girara_input_history_file_class_s {
+  GObjectClass parent_class;
+};
+
+#define GIRARA_TYPE_INPUT_HISTORY_FILE \
+  (girara_input_history_file_get_type())
+#define GIRARA_INPUT_HISTORY_FILE(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj), GIRARA_TYPE_INPUT_HISTORY_FILE, GiraraInputHistoryFile))
+#define GIRARA_IS_INPUT_HISTORY_FILE(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj), GIRARA_TYPE_INPUT_HISTORY_FILE))
+
+/**
+ * Returns the type of the file based input history storage.
+ *
+ * @return the type
+ */
+GType girara_input_history_file_get_type(void);
+
+/**
+ * Create a GiraraInputHistoryIO object that stores the history in a plain
+ * text file, one input per line. The file may be shared between several
+ * processes: appends are serialized with advisory locks and every instance
+ * only reads the lines added since its last read.
+ *
+ * @param path path to the history file
+ * @returns a GiraraInputHistoryIO object
+ */
+GiraraInputHistoryIO* girara_input_history_file_new(const char* path);
+
 
 struct girara_input_history_s {
   GObject parent;
@@ -8,6 +8,7 @@
 
 #include "types.h"
 #include "macros.h"
+#include "commands.h"
 
 #define FORMAT_COMMAND "<b>%s</b>"
 #define FORMAT_DESCRIPTION "<i>%s</i>"
@@ -24,14 +25,39 @@
  */
 HIDDEN void girara_setting_free(girara_setting_t* setting);
 
+/**
+ * Free the string value of a girara_setting_t struct allocated from an arena
+ *
+ * @param setting The setting
+ */
+HIDDEN void girara_setting_free_value(girara_setting_t* setting);
+
 HIDDEN void girara_config_handle_free(girara_config_handle_t* handle);
 
 HIDDEN void girara_shortcut_mapping_free(girara_shortcut_mapping_t* mapping);
 
 HIDDEN void girara_shortcut_free(girara_shortcut_t* shortcut);
 
+/**
+ * Releases the shortcuts of transactions that have not been committed
+ *
+ * @param session The girara session
+ */
+HIDDEN void girara_shortcut_transaction_free(girara_session_t* session);
+
 HIDDEN void girara_inputbar_shortcut_free(girara_inputbar_shortcut_t* shortcut);
 
+/**
+ * Looks up an inputbar shortcut
+ *
+ * @param session The girara session
+ * @param modifier The modifier
+ * @param key The key
+ * @return The inputbar shortcut or NULL if there is none
+ */
+HIDDEN girara_inputbar_shortcut_t* girara_inputbar_shortcut_find(
+    girara_session_t* session, guint modifier, guint key);
+
 HIDDEN void girara_mode_string_free(girara_mode_string_t* mode);
 
 HIDDEN void girara_statusbar_item_free(girara_statusbar_item_t* statusbaritem);
@@ -44,8 +70,168 @@ HIDDEN void girara_special_command_free(
 
 HIDDEN void girara_command_free(girara_command_t* command);
 
+/**
+ * Looks up an inputbar command by its name or abbreviation
+ *
+ * @param session The girara session
+ * @param name Name or abbreviation
+ * @return The command or NULL if there is none
+ */
+HIDDEN girara_command_t* girara_command_find(girara_session_t* session,
+    const char* name);
+
+/**
+ * Returns the inputbar commands whose name or abbreviation starts with the
+ * given prefix, sorted by the matching name
+ *
+ * @param session The girara session
+ * @param prefix The prefix (NULL matches all commands)
+ * @return List of commands that has to be freed by the caller
+ */
+HIDDEN girara_list_t* girara_command_find_prefix(girara_session_t* session,
+    const char* prefix);
+
+/**
+ * Stops a pending execution of a special command and cancels the last one
+ *
+ * @param special_command The special command
+ */
+HIDDEN void girara_special_command_cancel(
+    girara_special_command_t* special_command);
+
+/**
+ * Evaluates a special command for changed input, taking the debounce interval
+ * into account
+ *
+ * @param special_command The special command
+ * @param input The current input
+ */
+HIDDEN void girara_special_command_update(
+    girara_special_command_t* special_command, const char* input);
+
+/**
+ * Executes a special command for the final input of the inputbar
+ *
+ * @param special_command The special command
+ * @param input The input
+ */
+HIDDEN void girara_special_command_activate(
+    girara_special_command_t* special_command, const char* input);
+
+/**
+ * Outcome of running an inputbar line
+ */
+typedef enum girara_command_line_result_e
+{
+  GIRARA_COMMAND_LINE_INVALID, /**< The line is empty or could not be parsed */
+  GIRARA_COMMAND_LINE_SPECIAL, /**< A special command handled the line */
+  GIRARA_COMMAND_LINE_COMMAND, /**< A command or the unknown command handler handled the line */
+  GIRARA_COMMAND_LINE_UNKNOWN /**< No command handled the line */
+} girara_command_line_result_t;
+
+/**
+ * Runs an inputbar line
+ *
+ * @param session The used girara session
+ * @param line The line including the command identifier
+ * @param event_time Time of the event that caused the run
+ * @return The outcome
+ */
+HIDDEN girara_command_line_result_t girara_command_line_run(
+    girara_session_t* session, const char* line, guint32 event_time);
+
 HIDDEN void girara_mouse_event_free(girara_mouse_event_t* mouse_event);
 
+/**
+ * Looks up the mouse binding that handles an event
+ *
+ * @param session The girara session
+ * @param event_type The event type
+ * @param mode The current mode
+ * @param mask The modifier mask of the event
+ * @param button The button (ignored for motion and scroll events)
+ * @return The mouse binding or NULL if there is none
+ */
+HIDDEN girara_mouse_event_t* girara_mouse_event_find(girara_session_t* session,
+    girara_event_type_t event_type, girara_mode_t mode, guint mask,
+    guint button);
+
+typedef struct girara_arena_s girara_arena_t;
+
+/**
+ * Creates a new arena. Memory allocated from an arena is only released once
+ * the whole arena is freed.
+ *
+ * @return The arena
+ */
+HIDDEN girara_arena_t* girara_arena_new(void);
+
+/**
+ * Frees an arena and all memory allocated from it
+ *
+ * @param arena The arena
+ */
+HIDDEN void girara_arena_free(girara_arena_t* arena);
+
+/**
+ * Allocates zero-initialized memory from an arena
+ *
+ * @param arena The arena
+ * @param size Number of bytes
+ * @return The allocated memory
+ */
+HIDDEN void* girara_arena_alloc(girara_arena_t* arena, size_t size);
+
+/**
+ * Copies a string into an arena
+ *
+ * @param arena The arena
+ * @param str The string (can be NULL)
+ * @return The copy or NULL if str is NULL
+ */
+HIDDEN char* girara_arena_strdup(girara_arena_t* arena, const char* str);
+
+/**
+ * Returns the number of bytes reserved by an arena
+ *
+ * @param arena The arena
+ * @return Number of reserved bytes
+ */
+HIDDEN size_t girara_arena_get_size(girara_arena_t* arena);
+
+/**
+ * Allocates a zero-initialized registry object for the session. Without an
+ * arena the memory is allocated with g_slice and released by the free
+ * function of the registry.
+ *
+ * @param session The girara session
+ * @param category The category of the object
+ * @param size Size of the object
+ * @return The allocated object
+ */
+HIDDEN void* girara_session_alloc(girara_session_t* session,
+    girara_memory_category_t category, size_t size);
+
+/**
+ * Copies a string that belongs to a registry object of the session
+ *
+ * @param session The girara session
+ * @param category The category of the owning object
+ * @param str The string (can be NULL)
+ * @return The copy or NULL if str is NULL
+ */
+HIDDEN char* girara_session_strdup(girara_session_t* session,
+    girara_memory_category_t category, const char* str);
+
+/**
+ * Frees a string allocated with girara_session_strdup. Strings of an arena
+ * are kept until the session is destroyed.
+ *
+ * @param session The girara session
+ * @param str The string
+ */
+HIDDEN void girara_session_strfree(girara_session_t* session, char* str);
+
 HIDDEN void girara_config_load_default(girara_session_t* session);
 
 HIDDEN void update_state_by_keyval(int *state, int keyval);
@@ -128,6 +314,292 @@ HIDDEN bool girara_cmd_exec(girara_session_t* session,
 HIDDEN bool girara_sc_feedkeys(girara_session_t* session, girara_argument_t* argument,
     girara_event_t* event, unsigned int t);
 
+/**
+ * Key of a parsed key sequence
+ */
+typedef struct girara_key_s
+{
+  guint keyval; /**< Key value */
+  guint state; /**< Modifiers given explicitly in the sequence */
+} girara_key_t;
+
+/**
+ * Key sequence as given to feedkeys parsed into its keys
+ */
+typedef struct girara_key_sequence_s
+{
+  unsigned int refs; /**< Reference count */
+  size_t length; /**< Number of keys */
+  girara_key_t keys[]; /**< Keys of the sequence */
+} girara_key_sequence_t;
+
+/**
+ * Releases a reference of a parsed key sequence
+ *
+ * @param sequence The key sequence (can be NULL)
+ */
+HIDDEN void girara_key_sequence_unref(girara_key_sequence_t* sequence);
+
+/**
+ * Number of buckets of a latency histogram
+ */
+#define GIRARA_LATENCY_BUCKETS 32
+
+/**
+ * Histogram with power of two buckets
+ */
+typedef struct girara_histogram_s
+{
+  unsigned int buckets[GIRARA_LATENCY_BUCKETS]; /**< Number of values per bucket */
+  unsigned int count; /**< Number of values */
+  guint64 max; /**< Maximal value */
+} girara_histogram_t;
+
+/**
+ * Latencies of an input source or a binding in microseconds
+ */
+typedef struct girara_latency_s
+{
+  girara_histogram_t delay; /**< Delay from the event to the handler */
+  girara_histogram_t duration; /**< Execution time of the handler */
+} girara_latency_t;
+
+/**
+ * Returns the latencies of a binding, creating them if necessary
+ *
+ * @param session The session
+ * @param binding Name of the binding
+ * @return The latencies of the binding
+ */
+HIDDEN girara_latency_t* girara_latency_get(girara_session_t* session,
+    const char* binding);
+
+/**
+ * Records the latency of a handler that has just returned
+ *
+ * @param session The session
+ * @param source The input source that triggered the handler
+ * @param binding Latencies of the binding or NULL
+ * @param event_time Time of the GDK event or GDK_CURRENT_TIME if unknown
+ * @param start Monotonic time at which the handler started
+ */
+HIDDEN void girara_latency_record(girara_session_t* session,
+    girara_latency_source_t source, girara_latency_t* binding,
+    guint32 event_time, gint64 start);
+
+/**
+ * Returns the latency binding name of a shortcut
+ *
+ * @param mask The modifier mask
+ * @param key The key
+ * @param buffer The buffered command or NULL
+ * @return The name that has to be freed
+ */
+HIDDEN char* girara_latency_shortcut_name(guint mask, guint key,
+    const char* buffer);
+
+/**
+ * Returns the latency binding name of a mouse event
+ *
+ * @param mask The modifier mask
+ * @param button The button
+ * @param type The event type
+ * @return The name that has to be freed
+ */
+HIDDEN char* girara_latency_mouse_event_name(guint mask, guint button,
+    girara_event_type_t type);
+
+/**
+ * Returns the latency source of a mouse event type
+ *
+ * @param type The event type
+ * @return The latency source
+ */
+HIDDEN girara_latency_source_t girara_latency_mouse_source(
+    girara_event_type_t type);
+
+/**
+ * Default command to report the measured latencies
+ *
+ * @param session The used girara session
+ * @param argument_list List of passed arguments
+ * @return TRUE No error occured
+ * @return FALSE An error occured
+ */
+HIDDEN bool girara_cmd_latency(girara_session_t* session,
+    girara_list_t* argument_list);
+
+/**
+ * Returns the profile entry of a shortcut function
+ *
+ * @param session The session
+ * @param function The shortcut function
+ * @return The profile entry
+ */
+HIDDEN girara_profile_entry_t* girara_profile_shortcut(girara_session_t* session,
+    girara_shortcut_function_t function);
+
+/**
+ * Returns the profile entry of a command
+ *
+ * @param session The session
+ * @param name The name of the command
+ * @return The profile entry
+ */
+HIDDEN girara_profile_entry_t* girara_profile_command(girara_session_t* session,
+    const char* name);
+
+/**
+ * Returns the profile entry of the callback of a setting
+ *
+ * @param session The session
+ * @param name The name of the setting
+ * @return The profile entry
+ */
+HIDDEN girara_profile_entry_t* girara_profile_setting(girara_session_t* session,
+    const char* name);
+
+/**
+ * Returns the CPU time of the calling thread to be passed to
+ * girara_profile_end
+ *
+ * @return CPU time in microseconds
+ */
+HIDDEN gint64 girara_profile_begin(void);
+
+/**
+ * Accounts an invocation of a handler
+ *
+ * @param entry The profile entry of the handler
+ * @param start The value returned by girara_profile_begin before the call
+ */
+HIDDEN void girara_profile_end(girara_profile_entry_t* entry, gint64 start);
+
+/**
+ * Frees a profile entry
+ *
+ * @param entry The profile entry
+ */
+HIDDEN void girara_profile_entry_free(girara_profile_entry_t* entry);
+
+/**
+ * Starts a trace span. Spans are only recorded if the GIRARA_TRACE
+ * environment variable names a file, which then receives them in the Chrome
+ * trace event format. Spans are only recorded on the thread that started the
+ * first span, normally the main thread; calls from other threads are ignored.
+ *
+ * @return Start of the span to be passed to girara_trace_end, 0 if tracing is
+ *   disabled
+ */
+HIDDEN gint64 girara_trace_begin(void);
+
+/**
+ * Ends a trace span
+ *
+ * @param name Name of the span
+ * @param detail Additional information, e.g. a file name, or NULL
+ * @param start The value returned by girara_trace_begin
+ */
+HIDDEN void girara_trace_end(const char* name, const char* detail, gint64 start);
+
+/**
+ * Child process spawned by girara_spawn
+ */
+typedef struct girara_child_s girara_child_t;
+
+/**
+ * Detaches the running children from the session. They are still reaped,
+ * but their output and exit status are no longer reported.
+ *
+ * @param session The used girara session
+ */
+HIDDEN void girara_children_detach(girara_session_t* session);
+
+/**
+ * Key recorded into a macro register
+ */
+typedef struct girara_macro_key_s
+{
+  guint keyval; /**< Key value */
+  guint mask; /**< Clean modifiers, or the full state for inputbar keys */
+  girara_mode_t mode; /**< Mode the key was pressed in */
+  bool inputbar; /**< Whether the key was typed into the inputbar */
+} girara_macro_key_t;
+
+/**
+ * What the next key pressed in the view selects a register for
+ */
+typedef enum girara_macro_pending_e
+{
+  GIRARA_MACRO_NONE, /**< Nothing */
+  GIRARA_MACRO_RECORD, /**< Start recording into the register */
+  GIRARA_MACRO_REPLAY /**< Replay the register */
+} girara_macro_pending_t;
+
+/**
+ * Records a key dispatched to the view and handles register selection. Keys
+ * fed by feedkeys or by a replay are not recorded.
+ *
+ * @param session The session
+ * @param keyval The translated key value
+ * @param clean The modifiers not consumed by the translation
+ * @return true if the key selected a register and must not be dispatched
+ */
+HIDDEN bool girara_macro_key_press(girara_session_t* session, guint keyval,
+    guint clean);
+
+/**
+ * Records a key typed into the inputbar unless it has been fed by feedkeys or
+ * by a replay
+ *
+ * @param session The session
+ * @param keyval The key value of the event
+ * @param state The modifier state of the event
+ */
+HIDDEN void girara_macro_inputbar_key_press(girara_session_t* session,
+    guint keyval, guint state);
+
+/**
+ * Kinds of names that can be given in angle brackets to map and feedkeys
+ */
+typedef enum girara_special_name_type_e
+{
+  GIRARA_SPECIAL_NAME_KEY, /**< Key, e.g. <Esc> */
+  GIRARA_SPECIAL_NAME_BUTTON, /**< Mouse button, e.g. <Button1> */
+  GIRARA_SPECIAL_NAME_EVENT, /**< Mouse event without button, e.g. <scroll_up> */
+  GIRARA_SPECIAL_NAME_BUTTON_EVENT /**< Mouse button event, e.g. [button-released] */
+} girara_special_name_type_t;
+
+/**
+ * Special name and its value
+ */
+typedef struct girara_special_name_s
+{
+  const char* identifier; /**< Name */
+  girara_special_name_type_t type; /**< Kind of the name */
+  int value; /**< Key value, button or event type */
+} girara_special_name_t;
+
+/**
+ * Looks up a special name
+ *
+ * @param name The name without brackets
+ * @return The special name or NULL if it is unknown
+ */
+HIDDEN const girara_special_name_t* girara_special_name_find(const char* name);
+
+/**
+ * Dispatches a key press to the shortcuts of the view as if it was typed by
+ * the user
+ *
+ * @param session The session
+ * @param keyval The translated key value
+ * @param clean The modifiers not consumed by the translation
+ * @return true if the key has been handled
+ */
+HIDDEN bool girara_key_dispatch(girara_session_t* session, guint keyval,
+    guint clean);
+
 /**
  * Structure of a command
  */
@@ -138,6 +610,7 @@ struct girara_command_s
   girara_command_function_t function; /**< Function */
   girara_completion_function_t completion; /**< Completion function */
   char* description; /**< Description of the command */
+  girara_latency_t* latency; /**< Latencies of the command */
 };
 
 struct girara_mode_string_s
@@ -175,6 +648,9 @@ struct girara_shortcut_s
   girara_shortcut_function_t function; /**< The correspondending function */
   girara_mode_t mode; /**< Mode identifier */
   girara_argument_t argument; /**< Given argument */
+  bool count_aware; /**< The function handles the count itself */
+  girara_latency_t* latency; /**< Latencies of the binding */
+  girara_key_sequence_t* key_sequence; /**< Parsed argument of feedkeys */
 };
 
 /**
@@ -188,6 +664,15 @@ struct girara_inputbar_shortcut_s
   girara_argument_t argument; /**< Given argument */
 };
 
+/**
+ * Entry of the sorted index of command names and abbreviations
+ */
+typedef struct girara_command_key_s
+{
+  const char* key; /**< Name or abbreviation, shared with the command */
+  girara_command_t* command; /**< The command */
+} girara_command_key_t;
+
 /**
  * Structure of a special command
  */
@@ -197,6 +682,14 @@ struct girara_special_command_s
   girara_inputbar_special_function_t function; /**< Function */
   bool always; /**< Evalute on every change of the input */
   girara_argument_t argument; /**< Argument */
+  girara_inputbar_special_cancellable_function_t cancellable_function; /**< Cancellable function */
+  unsigned int debounce; /**< Milliseconds to wait for further input */
+  girara_session_t* session; /**< Session the command belongs to */
+  char* pending_input; /**< Input waiting for the debounce interval */
+  guint timeout; /**< Debounce timeout */
+  GCancellable* cancellable; /**< Cancellable of the last execution */
+  char* live_input; /**< Input the inputbar evaluated the command for last */
+  girara_latency_t* latency; /**< Latencies of the command */
 };
 
 /**
@@ -210,6 +703,11 @@ struct girara_mouse_event_s
   girara_mode_t mode; /**< Allowed modes */
   girara_event_type_t event_type; /**< Event type */
   girara_argument_t argument; /**< Given argument */
+  bool coalesce; /**< Dispatch at most once per frame */
+  girara_event_t pending_event; /**< Last event collected for the next frame */
+  unsigned int pending_count; /**< Number of events collected for the next frame */
+  guint32 pending_time; /**< Time of the first event collected for the next frame */
+  girara_latency_t* latency; /**< Latencies of the binding */
 };
 
 /**
@@ -230,6 +728,24 @@ struct girara_statusbar_item_s
   GtkLabel *text; /**< Text label */
 };
 
+/**
+ * Number of entries of the key translation cache
+ */
+#define GIRARA_KEY_TRANSLATION_CACHE_SIZE 256
+
+/**
+ * Cached translation of a hardware key press
+ */
+typedef struct girara_key_translation_s
+{
+  bool valid; /**< Whether the entry holds a translation */
+  guint hardware_keycode; /**< Hardware keycode of the key press */
+  GdkModifierType state; /**< Modifier state of the key press */
+  gint group; /**< Keyboard group of the key press */
+  guint keyval; /**< Translated and normalized key value */
+  guint clean; /**< Modifiers not consumed by the translation */
+} girara_key_translation_t;
+
 /**
  * Private data of the girara session
  */
@@ -245,6 +761,177 @@ struct girara_session_private_s
    */
   girara_list_t* settings;
 
+  /**
+   * Settings indexed by their name
+   */
+  girara_map_t* setting_index;
+
+  /**
+   * Config handles indexed by their identifier
+   */
+  girara_map_t* config_handles;
+
+  /**
+   * Shortcut mappings indexed by their identifier
+   */
+  girara_map_t* shortcut_mapping_index;
+
+  /**
+   * Argument mappings indexed by their identifier
+   */
+  girara_map_t* argument_mapping_index;
+
+  /**
+   * Modes indexed by their name
+   */
+  girara_map_t* mode_index;
+
+  /**
+   * Mode that has been added last
+   */
+  girara_mode_t last_mode;
+
+  /**
+   * Inputbar commands indexed by name and abbreviation
+   */
+  girara_map_t* command_index;
+
+  /**
+   * Names and abbreviations of the inputbar commands in sorted order
+   */
+  GArray* command_keys;
+
+  /**
+   * Shortcut transaction
+   */
+  struct
+  {
+    unsigned int depth; /**< Number of nested transactions */
+    girara_list_t* pending; /**< Shortcuts added during the transaction */
+  } shortcut_transaction;
+
+  /**
+   * Inputbar shortcuts indexed by their key
+   */
+  girara_map_t* inputbar_shortcut_index;
+
+  /**
+   * Special commands indexed by their identifier
+   */
+  girara_special_command_t* special_command_table[256];
+
+  /**
+   * Live special command that processed the last input change
+   */
+  girara_special_command_t* active_special_command;
+
+  /**
+   * State of feedkeys
+   */
+  struct
+  {
+    girara_shortcut_t* shortcut; /**< Shortcut whose function is running */
+    unsigned int passthrough; /**< Fed keys passed on to GTK that the view ignores */
+    unsigned int depth; /**< Nesting depth of running feedkeys */
+  } feedkeys;
+
+  /**
+   * Latency measurements
+   */
+  struct
+  {
+    girara_latency_t sources[GIRARA_LATENCY_SOURCE_COUNT]; /**< Latencies per input source */
+    girara_map_t* bindings; /**< Latencies per binding name */
+    guint32 event_time; /**< Time of the event that is being handled */
+  } latency;
+
+  /**
+   * Profile entries of the handlers indexed by their kind and their name, or
+   * their function for shortcuts
+   */
+  girara_map_t* profile;
+
+  /**
+   * Running children indexed by their process id
+   */
+  girara_map_t* children;
+
+  /**
+   * State of macro recording and replay
+   */
+  struct
+  {
+    girara_map_t* registers; /**< Recorded keys (GArray of girara_macro_key_t) by register */
+    GArray* recording; /**< Keys of the register that is being recorded */
+    guint recording_length; /**< Length of the recording before the current key */
+    girara_macro_pending_t pending; /**< What the next key selects a register for */
+    unsigned int count; /**< Number of times to replay the selected register */
+    unsigned int depth; /**< Nesting depth of running replays */
+  } macro;
+
+  /**
+   * Translations of recent key presses, cleared when the keymap changes
+   */
+  girara_key_translation_t key_translations[GIRARA_KEY_TRANSLATION_CACHE_SIZE];
+
+  /**
+   * Handler of the keymap's keys-changed signal
+   */
+  gulong keymap_keys_changed;
+
+  /**
+   * Mouse events indexed by event type, mode, mask and button
+   */
+  girara_map_t* mouse_event_index;
+
+  /**
+   * Coalesced mouse events waiting for the next frame
+   */
+  girara_list_t* pending_mouse_events;
+
+  /**
+   * Tick callback that dispatches the pending mouse events
+   */
+  guint mouse_event_tick;
+
+  /**
+   * State of smooth scrolling
+   */
+  struct
+  {
+    double dx; /**< Horizontal delta not yet dispatched as discrete steps */
+    double dy; /**< Vertical delta not yet dispatched as discrete steps */
+    double vx; /**< Horizontal velocity in scroll units per millisecond */
+    double vy; /**< Vertical velocity in scroll units per millisecond */
+    guint32 time; /**< Time of the last smooth scroll event */
+    guint state; /**< Modifier state of the last smooth scroll event */
+    double x; /**< X coordinate of the last smooth scroll event */
+    double y; /**< Y coordinate of the last smooth scroll event */
+    gint64 frame_time; /**< Frame time of the last kinetic scroll step */
+    guint tick; /**< Tick callback of kinetic scrolling */
+  } scroll;
+
+  /**
+   * Arena for the registries, NULL unless GIRARA_SESSION_ARENA was given
+   */
+  girara_arena_t* arena;
+
+  /**
+   * The session has no widgets, see GIRARA_SESSION_HEADLESS
+   */
+  bool headless;
+
+  /**
+   * girara_session_init has packed the widgets, so lazily created widgets are
+   * packed right away
+   */
+  bool initialized;
+
+  /**
+   * Memory allocated from the arena per category
+   */
+  girara_memory_stats_t memory_stats[GIRARA_MEMORY_CATEGORY_COUNT];
+
   /**
    * Template enginge for CSS.
    */
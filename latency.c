@@ -0,0 +1,291 @@
+/* See LICENSE file for license and copyright information */
+
+#include <string.h>
+#include <glib.h>
+#include <glib/gi18n-lib.h>
+#include <gtk/gtk.h>
+
+#include "datastructures.h"
+#include "internal.h"
+#include "session.h"
+
+/* delays longer than this stem from events with a different time base */
+static const guint32 LATENCY_MAX_DELAY = 60 * 1000;
+
+static const char* const latency_source_names[GIRARA_LATENCY_SOURCE_COUNT] = {
+  "key press",
+  "button press",
+  "button release",
+  "motion",
+  "scroll",
+  "inputbar activate"
+};
+
+static unsigned int
+histogram_bucket(guint64 value)
+{
+  /* bucket n > 0 holds the values in [2^(n-1), 2^n) */
+  const unsigned int bucket = value == 0 ? 0 : g_bit_storage(value);
+  return MIN(bucket, GIRARA_LATENCY_BUCKETS - 1);
+}
+
+static void
+histogram_add(girara_histogram_t* histogram, guint64 value)
+{
+  histogram->buckets[histogram_bucket(value)]++;
+  histogram->count++;
+  histogram->max = MAX(histogram->max, value);
+}
+
+static unsigned long
+histogram_percentile(const girara_histogram_t* histogram, unsigned int percent)
+{
+  if (histogram->count == 0) {
+    return 0;
+  }
+
+  /* rank of the requested value, rounded up */
+  const guint64 rank = ((guint64) histogram->count * percent + 99) / 100;
+
+  guint64 seen = 0;
+  for (unsigned int i = 0; i < GIRARA_LATENCY_BUCKETS; i++) {
+    seen += histogram->buckets[i];
+    if (seen >= rank) {
+      /* report the upper bound of the bucket, but never more than the maximum */
+      const guint64 bound = (i == 0) ? 0 : (((guint64) 1 << i) - 1);
+      return MIN(bound, histogram->max);
+    }
+  }
+
+  return histogram->max;
+}
+
+static void
+latency_fill_stats(const girara_latency_t* latency, girara_latency_stats_t* stats)
+{
+  stats->count        = latency->duration.count;
+  stats->delay_p50    = histogram_percentile(&latency->delay, 50);
+  stats->delay_p99    = histogram_percentile(&latency->delay, 99);
+  stats->delay_max    = latency->delay.max;
+  stats->duration_p50 = histogram_percentile(&latency->duration, 50);
+  stats->duration_p99 = histogram_percentile(&latency->duration, 99);
+  stats->duration_max = latency->duration.max;
+}
+
+girara_latency_t*
+girara_latency_get(girara_session_t* session, const char* binding)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+  g_return_val_if_fail(binding != NULL, NULL);
+
+  girara_latency_t* latency = girara_map_get(session->private_data->latency.bindings, binding);
+  if (latency == NULL) {
+    latency = g_malloc0(sizeof(girara_latency_t));
+    girara_map_set(session->private_data->latency.bindings, binding, latency);
+  }
+
+  return latency;
+}
+
+void
+girara_latency_record(girara_session_t* session, girara_latency_source_t source,
+    girara_latency_t* binding, guint32 event_time, gint64 start)
+{
+  g_return_if_fail(session != NULL);
+  g_return_if_fail(source < GIRARA_LATENCY_SOURCE_COUNT);
+
+  const gint64 end = g_get_monotonic_time();
+  const guint64 duration = end > start ? end - start : 0;
+
+  /* GDK event times are milliseconds of the monotonic clock */
+  const guint32 delay = (guint32) (start / 1000) - event_time;
+  const bool has_delay = event_time != GDK_CURRENT_TIME && delay <= LATENCY_MAX_DELAY;
+
+  girara_latency_t* latencies[] = {
+    &session->private_data->latency.sources[source],
+    binding
+  };
+
+  for (size_t i = 0; i < LENGTH(latencies); i++) {
+    if (latencies[i] == NULL) {
+      continue;
+    }
+
+    histogram_add(&latencies[i]->duration, duration);
+    if (has_delay == true) {
+      histogram_add(&latencies[i]->delay, (guint64) delay * 1000);
+    }
+  }
+}
+
+char*
+girara_latency_shortcut_name(guint mask, guint key, const char* buffer)
+{
+  if (buffer != NULL) {
+    return g_strdup(buffer);
+  }
+
+  if (mask == 0 && key >= 0x21 && key <= 0x7E) {
+    return g_strdup_printf("%c", key);
+  }
+
+  const char* name = gdk_keyval_name(key);
+  return g_strdup_printf("<%s%s%s%s>",
+      (mask & GDK_CONTROL_MASK) ? "C-" : "",
+      (mask & GDK_MOD1_MASK)    ? "A-" : "",
+      (mask & GDK_SHIFT_MASK)   ? "S-" : "",
+      name != NULL ? name : "?");
+}
+
+char*
+girara_latency_mouse_event_name(guint mask, guint button,
+    girara_event_type_t type)
+{
+  static const char* const event_names[] = {
+    "Button%u",
+    "Button%u-2",
+    "Button%u-3",
+    "Button%u-released",
+    "motion",
+    "scroll_up",
+    "scroll_down",
+    "scroll_left",
+    "scroll_right",
+    "other",
+    "scroll_smooth"
+  };
+
+  const char* format = event_names[MIN((size_t) type, LENGTH(event_names) - 1)];
+  char* event = g_strdup_printf(format, button);
+  char* name  = g_strdup_printf("<%s%s%s%s>",
+      (mask & GDK_CONTROL_MASK) ? "C-" : "",
+      (mask & GDK_MOD1_MASK)    ? "A-" : "",
+      (mask & GDK_SHIFT_MASK)   ? "S-" : "",
+      event);
+  g_free(event);
+
+  return name;
+}
+
+girara_latency_source_t
+girara_latency_mouse_source(girara_event_type_t type)
+{
+  switch (type) {
+    case GIRARA_EVENT_BUTTON_RELEASE:
+      return GIRARA_LATENCY_BUTTON_RELEASE;
+    case GIRARA_EVENT_MOTION_NOTIFY:
+      return GIRARA_LATENCY_MOTION;
+    case GIRARA_EVENT_SCROLL_UP:
+    case GIRARA_EVENT_SCROLL_DOWN:
+    case GIRARA_EVENT_SCROLL_LEFT:
+    case GIRARA_EVENT_SCROLL_RIGHT:
+    case GIRARA_EVENT_SCROLL_BIDIRECTIONAL:
+      return GIRARA_LATENCY_SCROLL;
+    default:
+      return GIRARA_LATENCY_BUTTON_PRESS;
+  }
+}
+
+bool
+girara_session_get_latency_stats(girara_session_t* session,
+    girara_latency_source_t source, girara_latency_stats_t* stats)
+{
+  g_return_val_if_fail(session != NULL, false);
+  g_return_val_if_fail(source < GIRARA_LATENCY_SOURCE_COUNT, false);
+  g_return_val_if_fail(stats != NULL, false);
+
+  latency_fill_stats(&session->private_data->latency.sources[source], stats);
+  return true;
+}
+
+bool
+girara_session_get_binding_latency_stats(girara_session_t* session,
+    const char* binding, girara_latency_stats_t* stats)
+{
+  g_return_val_if_fail(session != NULL, false);
+  g_return_val_if_fail(binding != NULL, false);
+  g_return_val_if_fail(stats != NULL, false);
+
+  const girara_latency_t* latency = girara_map_get(session->private_data->latency.bindings, binding);
+  if (latency == NULL) {
+    return false;
+  }
+
+  latency_fill_stats(latency, stats);
+  return true;
+}
+
+girara_list_t*
+girara_session_get_latency_bindings(girara_session_t* session)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+
+  girara_list_t* bindings = girara_sorted_list_new2((girara_compare_function_t) g_strcmp0,
+      (girara_free_function_t) g_free);
+
+  girara_map_iterator_t storage;
+  girara_map_iterator_t* iter = girara_map_iterator_init(&storage,
+      session->private_data->latency.bindings);
+  while (girara_map_iterator_next(iter) == true) {
+    girara_list_append(bindings, g_strdup(girara_map_iterator_key(iter)));
+  }
+
+  return bindings;
+}
+
+static void
+latency_append(GString* report, const char* name, const girara_latency_t* latency)
+{
+  girara_latency_stats_t stats;
+  latency_fill_stats(latency, &stats);
+  if (stats.count == 0) {
+    return;
+  }
+
+  if (report->len != 0) {
+    g_string_append_c(report, '\n');
+  }
+
+  g_string_append_printf(report,
+      _("%s: %u events, delay p50 %lu µs, p99 %lu µs, max %lu µs, "
+        "handler p50 %lu µs, p99 %lu µs, max %lu µs"),
+      name, stats.count, stats.delay_p50, stats.delay_p99, stats.delay_max,
+      stats.duration_p50, stats.duration_p99, stats.duration_max);
+}
+
+bool
+girara_cmd_latency(girara_session_t* session, girara_list_t* argument_list)
+{
+  g_return_val_if_fail(session != NULL, false);
+
+  GString* report = g_string_new(NULL);
+
+  /* ":latency <binding> ..." reports the given bindings only */
+  if (argument_list != NULL && girara_list_size(argument_list) != 0) {
+    GIRARA_LIST_FOREACH_STACK(argument_list, const char*, iter, binding)
+      const girara_latency_t* latency = girara_map_get(session->private_data->latency.bindings, binding);
+      if (latency != NULL) {
+        latency_append(report, binding, latency);
+      }
+    GIRARA_LIST_FOREACH_STACK_END(argument_list, const char*, iter, binding);
+  } else {
+    for (unsigned int i = 0; i < GIRARA_LATENCY_SOURCE_COUNT; i++) {
+      latency_append(report, latency_source_names[i], &session->private_data->latency.sources[i]);
+    }
+
+    girara_list_t* bindings = girara_session_get_latency_bindings(session);
+    GIRARA_LIST_FOREACH_STACK(bindings, const char*, iter, binding)
+      latency_append(report, binding, girara_map_get(session->private_data->latency.bindings, binding));
+    GIRARA_LIST_FOREACH_STACK_END(bindings, const char*, iter, binding);
+    girara_list_free(bindings);
+  }
+
+  if (report->len == 0) {
+    girara_notify(session, GIRARA_INFO, _("No latencies have been measured yet"));
+  } else {
+    girara_notify(session, GIRARA_INFO, "%s", report->str);
+  }
+
+  g_string_free(report, TRUE);
+  return true;
+}
@@ -0,0 +1,201 @@
+/* See LICENSE file for license and copyright information */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <string.h>
+#include <time.h>
+#include <glib.h>
+#include <glib/gi18n-lib.h>
+
+#include "datastructures.h"
+#include "internal.h"
+#include "session.h"
+
+static const char* const profile_kind_names[] = {
+  "shortcut",
+  "command",
+  "setting"
+};
+
+static girara_profile_entry_t*
+profile_get(girara_session_t* session, girara_profile_kind_t kind, const char* id)
+{
+  /* handlers of different kinds might share an identifier */
+  char* key = g_strconcat(profile_kind_names[kind], ":", id, NULL);
+  girara_profile_entry_t* entry = girara_map_get(session->private_data->profile, key);
+  if (entry == NULL) {
+    entry = g_slice_new0(girara_profile_entry_t);
+    entry->kind = kind;
+    girara_map_set(session->private_data->profile, key, entry);
+  }
+
+  g_free(key);
+  return entry;
+}
+
+void
+girara_profile_entry_free(girara_profile_entry_t* entry)
+{
+  if (entry == NULL) {
+    return;
+  }
+
+  g_free((char*) entry->name);
+  g_slice_free(girara_profile_entry_t, entry);
+}
+
+girara_profile_entry_t*
+girara_profile_shortcut(girara_session_t* session,
+    girara_shortcut_function_t function)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+
+  char id[2 * sizeof(gintptr) + 3];
+  g_snprintf(id, sizeof(id), "0x%" G_GINTPTR_MODIFIER "x", (gintptr) function);
+
+  girara_profile_entry_t* entry = profile_get(session, GIRARA_PROFILE_SHORTCUT, id);
+  if (entry->name != NULL) {
+    return entry;
+  }
+
+  /* name shortcut functions like in the map command */
+  GIRARA_LIST_FOREACH_STACK(session->config.shortcut_mappings, girara_shortcut_mapping_t*, iter, mapping)
+    if (mapping->function == function) {
+      entry->name = g_strdup(mapping->identifier);
+      return entry;
+    }
+  GIRARA_LIST_FOREACH_STACK_END(session->config.shortcut_mappings, girara_shortcut_mapping_t*, iter, mapping);
+
+  entry->name = g_strdup(id);
+  return entry;
+}
+
+girara_profile_entry_t*
+girara_profile_command(girara_session_t* session, const char* name)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+  g_return_val_if_fail(name    != NULL, NULL);
+
+  girara_profile_entry_t* entry = profile_get(session, GIRARA_PROFILE_COMMAND, name);
+  if (entry->name == NULL) {
+    entry->name = g_strdup(name);
+  }
+
+  return entry;
+}
+
+girara_profile_entry_t*
+girara_profile_setting(girara_session_t* session, const char* name)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+  g_return_val_if_fail(name    != NULL, NULL);
+
+  girara_profile_entry_t* entry = profile_get(session, GIRARA_PROFILE_SETTING, name);
+  if (entry->name == NULL) {
+    entry->name = g_strdup(name);
+  }
+
+  return entry;
+}
+
+gint64
+girara_profile_begin(void)
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+    return (gint64) ts.tv_sec * G_USEC_PER_SEC + ts.tv_nsec / 1000;
+  }
+#endif
+
+  return g_get_monotonic_time();
+}
+
+void
+girara_profile_end(girara_profile_entry_t* entry, gint64 start)
+{
+  if (entry == NULL) {
+    return;
+  }
+
+  const gint64 end = girara_profile_begin();
+
+  entry->calls++;
+  if (end > start) {
+    entry->cpu_time += end - start;
+  }
+}
+
+static int
+profile_compare(const girara_profile_entry_t* lhs, const girara_profile_entry_t* rhs)
+{
+  /* most expensive first */
+  if (lhs->cpu_time != rhs->cpu_time) {
+    return lhs->cpu_time > rhs->cpu_time ? -1 : 1;
+  }
+  if (lhs->calls != rhs->calls) {
+    return lhs->calls > rhs->calls ? -1 : 1;
+  }
+
+  return g_strcmp0(lhs->name, rhs->name);
+}
+
+girara_list_t*
+girara_session_get_profile(girara_session_t* session)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+
+  girara_list_t* profile = girara_sorted_list_new2(
+      (girara_compare_function_t) profile_compare,
+      (girara_free_function_t) girara_profile_entry_free);
+
+  girara_map_iterator_t storage;
+  girara_map_iterator_t* iter = girara_map_iterator_init(&storage,
+      session->private_data->profile);
+  while (girara_map_iterator_next(iter) == true) {
+    const girara_profile_entry_t* entry = girara_map_iterator_value(iter);
+    if (entry->calls == 0) {
+      continue;
+    }
+
+    girara_profile_entry_t* copy = g_slice_dup(girara_profile_entry_t, entry);
+    copy->name = g_strdup(entry->name);
+    girara_list_append(profile, copy);
+  }
+
+  return profile;
+}
+
+char*
+girara_session_get_profile_report(girara_session_t* session)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+
+  girara_list_t* profile = girara_session_get_profile(session);
+  GString* report = g_string_new(NULL);
+
+  GIRARA_LIST_FOREACH_STACK(profile, girara_profile_entry_t*, iter, entry)
+    g_string_append_printf(report,
+        _("%s (%s): %lu calls, %.3f ms CPU time, %.1f µs per call\n"),
+        entry->name, profile_kind_names[entry->kind], entry->calls,
+        entry->cpu_time / 1000.0, (double) entry->cpu_time / entry->calls);
+  GIRARA_LIST_FOREACH_STACK_END(profile, girara_profile_entry_t*, iter, entry);
+
+  girara_list_free(profile);
+  return g_string_free(report, FALSE);
+}
+
+void
+girara_session_reset_profile(girara_session_t* session)
+{
+  g_return_if_fail(session != NULL);
+
+  girara_map_iterator_t storage;
+  girara_map_iterator_t* iter = girara_map_iterator_init(&storage,
+      session->private_data->profile);
+  while (girara_map_iterator_next(iter) == true) {
+    girara_profile_entry_t* entry = girara_map_iterator_value(iter);
+    entry->calls    = 0;
+    entry->cpu_time = 0;
+  }
+}
@@ -1,6 +1,7 @@
 /* See LICENSE file for license and copyright information */
 
 #include <stdlib.h>
+#include <string.h>
 #include <glib/gi18n-lib.h>
 
 #ifdef WITH_LIBNOTIFY
@@ -80,6 +81,7 @@ init_template_engine(GiraraTemplate* csstemplate)
 static void
 fill_template_with_values(girara_session_t* session)
 {
+  const gint64 trace          = girara_trace_begin();
   GiraraTemplate* csstemplate = session->private_data->csstemplate;
 
   girara_template_set_variable_value(csstemplate, "session",
@@ -178,13 +180,18 @@ fill_template_with_values(girara_session_t* session)
         padding_mapping[i].identifier, padding_mapping[i].value);
     g_free(padding_mapping[i].value);
   }
+
+  girara_trace_end("fill_template_with_values", NULL, trace);
 }
 
 static void
 css_template_changed(GiraraTemplate* csstemplate, girara_session_t* session)
 {
   GtkCssProvider* old = session->private_data->gtk.cssprovider;
-  char* css_data      = girara_template_evaluate(csstemplate);
+
+  const gint64 trace_evaluate = girara_trace_begin();
+  char* css_data              = girara_template_evaluate(csstemplate);
+  girara_trace_end("girara_template_evaluate", NULL, trace_evaluate);
   if (css_data == NULL) {
     girara_error("Error while evaluating templates.");
     return;
@@ -192,7 +199,11 @@ css_template_changed(GiraraTemplate* csstemplate, girara_session_t* session)
 
   GtkCssProvider* provider = gtk_css_provider_new();
   GError* error            = NULL;
-  if (gtk_css_provider_load_from_data(provider, css_data, -1, &error) == FALSE) {
+
+  const gint64 trace_load = girara_trace_begin();
+  const gboolean loaded   = gtk_css_provider_load_from_data(provider, css_data, -1, &error);
+  girara_trace_end("gtk_css_provider_load_from_data", NULL, trace_load);
+  if (loaded == FALSE) {
     girara_error("Unable to load CSS: %s", error->message);
     g_free(css_data);
     g_error_free(error);
@@ -215,25 +226,92 @@ css_template_changed(GiraraTemplate* csstemplate, girara_session_t* session)
   session->private_data->gtk.cssprovider = provider;
 }
 
+static void
+keymap_keys_changed(GdkKeymap* UNUSED(keymap), girara_session_t* session)
+{
+  memset(session->private_data->key_translations, 0,
+      sizeof(session->private_data->key_translations));
+}
+
+static void
+notification_area_pack(girara_session_t* session)
+{
+  GtkBox* bottom_box = session->private_data->gtk.bottom_box;
+  gtk_box_pack_end(bottom_box, session->gtk.notification_area, TRUE, TRUE, 0);
+  /* between the inputbar and the statusbar */
+  gtk_box_reorder_child(bottom_box, session->gtk.notification_area, 1);
+}
+
+static void
+inputbar_dialog_pack(girara_session_t* session)
+{
+  gtk_box_pack_start(session->gtk.inputbar_box,
+      GTK_WIDGET(session->gtk.inputbar_dialog), FALSE, FALSE, 0);
+  /* in front of the entry */
+  gtk_box_reorder_child(session->gtk.inputbar_box,
+      GTK_WIDGET(session->gtk.inputbar_dialog), 0);
+}
+
+static void
+tabbar_pack(girara_session_t* session)
+{
+  gtk_box_pack_start(session->gtk.box, session->gtk.tabbar, FALSE, FALSE, 0);
+  /* above the view */
+  gtk_box_reorder_child(session->gtk.box, session->gtk.tabbar, 0);
+}
+
+static girara_list_t*
+registry_list_new(girara_session_t* session, girara_free_function_t gfree)
+{
+  /* entries allocated from the arena are released together with it */
+  return girara_list_new2(session->private_data->arena == NULL ? gfree : NULL);
+}
+
 girara_session_t*
 girara_session_create()
 {
+  return girara_session_create2(GIRARA_SESSION_DEFAULT);
+}
+
+girara_session_t*
+girara_session_create2(girara_session_flags_t flags)
+{
+  const gint64 trace = girara_trace_begin();
+
   ensure_gettext_initialized();
 
   girara_session_t* session = g_slice_alloc0(sizeof(girara_session_t));
   session->private_data     = g_slice_alloc0(sizeof(girara_session_private_t));
 
+  if ((flags & GIRARA_SESSION_ARENA) != 0) {
+    session->private_data->arena = girara_arena_new();
+  }
+  session->private_data->headless = (flags & GIRARA_SESSION_HEADLESS) != 0;
+
   /* init values */
-  session->bindings.mouse_events       = girara_list_new2(
+  session->bindings.mouse_events       = registry_list_new(session,
       (girara_free_function_t) girara_mouse_event_free);
-  session->bindings.commands           = girara_list_new2(
+  session->private_data->mouse_event_index = girara_int_map_new2(
+      (girara_free_function_t) girara_list_free);
+  session->private_data->pending_mouse_events = girara_list_new();
+  session->bindings.commands           = registry_list_new(session,
       (girara_free_function_t) girara_command_free);
-  session->bindings.special_commands   = girara_list_new2(
+  session->private_data->command_index = girara_map_new();
+  session->private_data->command_keys  = g_array_new(FALSE, FALSE, sizeof(girara_command_key_t));
+  session->bindings.special_commands   = registry_list_new(session,
       (girara_free_function_t) girara_special_command_free);
-  session->bindings.shortcuts          = girara_list_new2(
+  session->bindings.shortcuts          = registry_list_new(session,
       (girara_free_function_t) girara_shortcut_free);
-  session->bindings.inputbar_shortcuts = girara_list_new2(
+  session->bindings.inputbar_shortcuts = registry_list_new(session,
       (girara_free_function_t) girara_inputbar_shortcut_free);
+  session->private_data->inputbar_shortcut_index = girara_int_map_new2(
+      (girara_free_function_t) girara_list_free);
+  session->private_data->macro.registers = girara_int_map_new2(
+      (girara_free_function_t) g_array_unref);
+  session->private_data->latency.bindings = girara_map_new2(g_free);
+  session->private_data->profile = girara_map_new2(
+      (girara_free_function_t) girara_profile_entry_free);
+  session->private_data->children = girara_int_map_new();
 
   session->elements.statusbar_items = girara_list_new2(
       (girara_free_function_t) girara_statusbar_item_free);
@@ -241,7 +319,10 @@ girara_session_create()
   /* settings */
   session->private_data->settings = girara_sorted_list_new2(
       (girara_compare_function_t) cb_sort_settings,
-      (girara_free_function_t) girara_setting_free);
+      session->private_data->arena == NULL ?
+      (girara_free_function_t) girara_setting_free :
+      (girara_free_function_t) girara_setting_free_value);
+  session->private_data->setting_index = girara_map_new();
 
   /* CSS style provider */
   session->private_data->csstemplate     = girara_template_new(CSS_TEMPLATE);
@@ -249,8 +330,9 @@ girara_session_create()
   init_template_engine(session->private_data->csstemplate);
 
   /* init modes */
-  session->modes.identifiers  = girara_list_new2(
+  session->modes.identifiers  = registry_list_new(session,
       (girara_free_function_t) girara_mode_string_free);
+  session->private_data->mode_index = girara_map_new();
   girara_mode_t normal_mode   = girara_mode_add(session, "normal");
   girara_mode_t inputbar_mode = girara_mode_add(session, "inputbar");
   session->modes.normal       = normal_mode;
@@ -258,40 +340,41 @@ girara_session_create()
   session->modes.inputbar     = inputbar_mode;
 
   /* config handles */
-  session->config.handles           = girara_list_new2(
+  session->config.handles           = registry_list_new(session,
       (girara_free_function_t) girara_config_handle_free);
-  session->config.shortcut_mappings = girara_list_new2(
+  session->private_data->config_handles = girara_map_new();
+  session->config.shortcut_mappings = registry_list_new(session,
       (girara_free_function_t) girara_shortcut_mapping_free);
-  session->config.argument_mappings = girara_list_new2(
+  session->private_data->shortcut_mapping_index = girara_map_new();
+  session->config.argument_mappings = registry_list_new(session,
       (girara_free_function_t) girara_argument_mapping_free);
+  session->private_data->argument_mapping_index = girara_map_new();
 
   /* command history */
   session->command_history = girara_input_history_new(NULL);
 
   /* load default values */
+  const gint64 trace_defaults = girara_trace_begin();
   girara_config_load_default(session);
+  girara_trace_end("girara_config_load_default", NULL, trace_defaults);
 
   /* create widgets */
-  session->gtk.box                      = GTK_BOX(gtk_box_new(GTK_ORIENTATION_VERTICAL, 0));
-  session->private_data->gtk.overlay    = gtk_overlay_new();
-  session->private_data->gtk.bottom_box = GTK_BOX(gtk_box_new(GTK_ORIENTATION_VERTICAL, 0));
-  session->gtk.statusbar_entries        = GTK_BOX(gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 0));
-  session->gtk.tabbar                   = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 0);
-  session->gtk.inputbar_box             = GTK_BOX(gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 0));
-  gtk_box_set_homogeneous(GTK_BOX(session->gtk.tabbar), TRUE);
-  gtk_box_set_homogeneous(session->gtk.inputbar_box, TRUE);
-  session->gtk.view              = gtk_scrolled_window_new(NULL, NULL);
-  session->gtk.viewport          = gtk_viewport_new(NULL, NULL);
+  if (session->private_data->headless == false) {
+    session->gtk.box                      = GTK_BOX(gtk_box_new(GTK_ORIENTATION_VERTICAL, 0));
+    session->private_data->gtk.overlay    = gtk_overlay_new();
+    session->private_data->gtk.bottom_box = GTK_BOX(gtk_box_new(GTK_ORIENTATION_VERTICAL, 0));
+    session->gtk.statusbar_entries        = GTK_BOX(gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 0));
+    session->gtk.inputbar_box             = GTK_BOX(gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 0));
+    gtk_box_set_homogeneous(session->gtk.inputbar_box, TRUE);
+    session->gtk.view              = gtk_scrolled_window_new(NULL, NULL);
+    session->gtk.viewport          = gtk_viewport_new(NULL, NULL);
 #if GTK_MAJOR_VERSION == 3 && GTK_MINOR_VERSION >= 4
-  gtk_widget_add_events(session->gtk.viewport, GDK_SCROLL_MASK);
+    gtk_widget_add_events(session->gtk.viewport, GDK_SCROLL_MASK);
 #endif
-  session->gtk.statusbar         = gtk_event_box_new();
-  session->gtk.notification_area = gtk_event_box_new();
-  session->gtk.notification_text = gtk_label_new(NULL);
-  session->gtk.inputbar_dialog   = GTK_LABEL(gtk_label_new(NULL));
-  session->gtk.inputbar_entry    = GTK_ENTRY(gtk_entry_new());
-  session->gtk.inputbar          = gtk_event_box_new();
-  session->gtk.tabs              = GTK_NOTEBOOK(gtk_notebook_new());
+    session->gtk.statusbar         = gtk_event_box_new();
+    session->gtk.inputbar_entry    = GTK_ENTRY(gtk_entry_new());
+    session->gtk.inputbar          = gtk_event_box_new();
+  }
 
   /* deprecated members */
   GIRARA_IGNORE_DEPRECATED
@@ -299,6 +382,8 @@ girara_session_create()
   session->global.command_history = girara_get_command_history(session);
   GIRARA_UNIGNORE
 
+  girara_trace_end("girara_session_create", NULL, trace);
+
   return session;
 }
 
@@ -309,14 +394,28 @@ girara_session_init(girara_session_t* session, const char* sessionname)
     return false;
   }
 
+  const gint64 trace = girara_trace_begin();
+
   session->private_data->session_name = g_strdup(
       (sessionname == NULL) ? "girara" : sessionname);
 
   /* load CSS style */
   fill_template_with_values(session);
+
+  /* without widgets there is neither a display nor a window */
+  if (session->private_data->headless == true) {
+    girara_trace_end("girara_session_init", session->private_data->session_name, trace);
+    return true;
+  }
+
   g_signal_connect(G_OBJECT(session->private_data->csstemplate), "changed",
       G_CALLBACK(css_template_changed), session);
 
+  /* key translations depend on the keymap */
+  session->private_data->keymap_keys_changed = g_signal_connect(
+      G_OBJECT(gdk_keymap_get_default()), "keys-changed",
+      G_CALLBACK(keymap_keys_changed), session);
+
   /* window */
   if (session->gtk.embed != 0) {
     session->gtk.window = gtk_plug_new(session->gtk.embed);
@@ -387,17 +486,11 @@ girara_session_init(girara_session_t* session, const char* sessionname)
   /* statusbar */
   gtk_container_add(GTK_CONTAINER(session->gtk.statusbar), GTK_WIDGET(session->gtk.statusbar_entries));
 
-  /* notification area */
-  gtk_container_add(GTK_CONTAINER(session->gtk.notification_area), session->gtk.notification_text);
-  gtk_misc_set_alignment(GTK_MISC(session->gtk.notification_text), 0.0, 0.5);
-  gtk_label_set_use_markup(GTK_LABEL(session->gtk.notification_text), TRUE);
-
   /* inputbar */
   gtk_entry_set_has_frame(session->gtk.inputbar_entry, FALSE);
   gtk_editable_set_editable(GTK_EDITABLE(session->gtk.inputbar_entry), TRUE);
 
   gtk_widget_set_name(GTK_WIDGET(session->gtk.inputbar_entry), "bottom_box");
-  gtk_widget_set_name(session->gtk.notification_text, "bottom_box");
 
   session->signals.inputbar_key_pressed = g_signal_connect(
       G_OBJECT(session->gtk.inputbar_entry),
@@ -424,25 +517,28 @@ girara_session_init(girara_session_t* session, const char* sessionname)
   gtk_box_set_spacing(session->gtk.inputbar_box, 5);
 
   /* inputbar box */
-  gtk_box_pack_start(GTK_BOX(session->gtk.inputbar_box),  GTK_WIDGET(session->gtk.inputbar_dialog), FALSE, FALSE, 0);
   gtk_box_pack_start(GTK_BOX(session->gtk.inputbar_box),  GTK_WIDGET(session->gtk.inputbar_entry),  TRUE,  TRUE,  0);
+  if (session->gtk.inputbar_dialog != NULL) {
+    inputbar_dialog_pack(session);
+  }
   gtk_container_add(GTK_CONTAINER(session->gtk.inputbar), GTK_WIDGET(session->gtk.inputbar_box));
 
   /* bottom box */
   gtk_box_set_spacing(session->private_data->gtk.bottom_box, 0);
 
   gtk_box_pack_end(GTK_BOX(session->private_data->gtk.bottom_box), GTK_WIDGET(session->gtk.inputbar), TRUE, TRUE, 0);
-  gtk_box_pack_end(GTK_BOX(session->private_data->gtk.bottom_box), GTK_WIDGET(session->gtk.notification_area), TRUE, TRUE, 0);
   gtk_box_pack_end(GTK_BOX(session->private_data->gtk.bottom_box), GTK_WIDGET(session->gtk.statusbar), TRUE, TRUE, 0);
-
-  /* tabs */
-  gtk_notebook_set_show_border(session->gtk.tabs, FALSE);
-  gtk_notebook_set_show_tabs(session->gtk.tabs,   FALSE);
+  if (session->gtk.notification_area != NULL) {
+    notification_area_pack(session);
+  }
 
   /* packing */
   gtk_box_set_spacing(session->gtk.box, 0);
-  gtk_box_pack_start(session->gtk.box, GTK_WIDGET(session->gtk.tabbar), FALSE, FALSE, 0);
   gtk_box_pack_start(session->gtk.box, GTK_WIDGET(session->gtk.view),   TRUE,  TRUE, 0);
+  if (session->gtk.tabbar != NULL) {
+    tabbar_pack(session);
+  }
+  session->private_data->initialized = true;
 
   /* box */
   gtk_container_add(GTK_CONTAINER(session->private_data->gtk.overlay), GTK_WIDGET(session->gtk.box));
@@ -459,13 +555,6 @@ girara_session_init(girara_session_t* session, const char* sessionname)
   /* inputbar */
   widget_add_class(GTK_WIDGET(session->gtk.inputbar_entry), "inputbar");
   widget_add_class(GTK_WIDGET(session->gtk.inputbar), "inputbar");
-  widget_add_class(GTK_WIDGET(session->gtk.inputbar_dialog), "inputbar");
-
-  /* notification area */
-  widget_add_class(session->gtk.notification_area, "notification");
-  widget_add_class(session->gtk.notification_text, "notification");
-  gtk_style_context_save(gtk_widget_get_style_context(session->gtk.notification_area));
-  gtk_style_context_save(gtk_widget_get_style_context(session->gtk.notification_text));
 
   /* set window size */
   int window_width = 0;
@@ -477,9 +566,15 @@ girara_session_init(girara_session_t* session, const char* sessionname)
     gtk_window_set_default_size(GTK_WINDOW(session->gtk.window), window_width, window_height);
   }
 
+  const gint64 trace_show = girara_trace_begin();
   gtk_widget_show_all(GTK_WIDGET(session->gtk.window));
-  gtk_widget_hide(GTK_WIDGET(session->gtk.notification_area));
-  gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar_dialog));
+  girara_trace_end("gtk_widget_show_all", NULL, trace_show);
+  if (session->gtk.notification_area != NULL) {
+    gtk_widget_hide(GTK_WIDGET(session->gtk.notification_area));
+  }
+  if (session->gtk.inputbar_dialog != NULL) {
+    gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar_dialog));
+  }
 
   if (session->global.autohide_inputbar == true) {
     gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar));
@@ -500,6 +595,8 @@ girara_session_init(girara_session_t* session, const char* sessionname)
 
   gtk_widget_grab_focus(GTK_WIDGET(session->gtk.view));
 
+  girara_trace_end("girara_session_init", session->private_data->session_name, trace);
+
   return true;
 }
 
@@ -523,9 +620,15 @@ girara_session_private_free(girara_session_private_t* session)
   session->csstemplate = NULL;
 
   /* clean up settings */
+  girara_map_free(session->setting_index);
+  session->setting_index = NULL;
   girara_list_free(session->settings);
   session->settings = NULL;
 
+  /* release all registry entries at once */
+  girara_arena_free(session->arena);
+  session->arena = NULL;
+
   g_slice_free(girara_session_private_t, session);
 }
 
@@ -542,22 +645,79 @@ girara_session_destroy(girara_session_t* session)
   GIRARA_UNIGNORE
 
   /* clean up shortcuts */
+  girara_shortcut_transaction_free(session);
+  if (session->private_data->arena != NULL) {
+    /* parsed key sequences are not part of the arena */
+    GIRARA_LIST_FOREACH_STACK(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut)
+      girara_key_sequence_unref(shortcut->key_sequence);
+      shortcut->key_sequence = NULL;
+    GIRARA_LIST_FOREACH_STACK_END(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut);
+  }
   girara_list_free(session->bindings.shortcuts);
   session->bindings.shortcuts = NULL;
 
   /* clean up inputbar shortcuts */
+  girara_map_free(session->private_data->inputbar_shortcut_index);
+  session->private_data->inputbar_shortcut_index = NULL;
   girara_list_free(session->bindings.inputbar_shortcuts);
   session->bindings.inputbar_shortcuts = NULL;
 
   /* clean up commands */
+  girara_map_free(session->private_data->command_index);
+  session->private_data->command_index = NULL;
+  g_array_free(session->private_data->command_keys, TRUE);
+  session->private_data->command_keys = NULL;
   girara_list_free(session->bindings.commands);
   session->bindings.commands = NULL;
 
   /* clean up special commands */
+  GIRARA_LIST_FOREACH_STACK(session->bindings.special_commands, girara_special_command_t*, iter, special_command)
+    girara_special_command_cancel(special_command);
+  GIRARA_LIST_FOREACH_STACK_END(session->bindings.special_commands, girara_special_command_t*, iter, special_command);
+  session->private_data->active_special_command = NULL;
   girara_list_free(session->bindings.special_commands);
   session->bindings.special_commands = NULL;
 
+  /* detach running children */
+  girara_children_detach(session);
+
+  /* clean up profile */
+  girara_map_free(session->private_data->profile);
+  session->private_data->profile = NULL;
+
+  /* clean up latency measurements */
+  girara_map_free(session->private_data->latency.bindings);
+  session->private_data->latency.bindings = NULL;
+
+  /* clean up macros */
+  girara_map_free(session->private_data->macro.registers);
+  session->private_data->macro.registers = NULL;
+  session->private_data->macro.recording = NULL;
+
+  /* clean up key translations */
+  if (session->private_data->keymap_keys_changed != 0) {
+    g_signal_handler_disconnect(G_OBJECT(gdk_keymap_get_default()),
+        session->private_data->keymap_keys_changed);
+    session->private_data->keymap_keys_changed = 0;
+  }
+
   /* clean up mouse events */
+#if GTK_CHECK_VERSION(3, 8, 0)
+  if (session->private_data->mouse_event_tick != 0) {
+    gtk_widget_remove_tick_callback(session->gtk.view,
+        session->private_data->mouse_event_tick);
+  }
+#endif
+#if GTK_CHECK_VERSION(3, 20, 0)
+  if (session->private_data->scroll.tick != 0) {
+    gtk_widget_remove_tick_callback(session->gtk.view,
+        session->private_data->scroll.tick);
+  }
+#endif
+  girara_list_free(session->private_data->pending_mouse_events);
+  session->private_data->pending_mouse_events = NULL;
+  girara_map_free(session->private_data->mouse_event_index);
+  session->private_data->mouse_event_index = NULL;
   girara_list_free(session->bindings.mouse_events);
   session->bindings.mouse_events = NULL;
 
@@ -570,18 +730,26 @@ girara_session_destroy(girara_session_t* session)
   session->elements.statusbar_items = NULL;
 
   /* clean up config handles */
+  girara_map_free(session->private_data->config_handles);
+  session->private_data->config_handles = NULL;
   girara_list_free(session->config.handles);
   session->config.handles = NULL;
 
   /* clean up shortcut mappings */
+  girara_map_free(session->private_data->shortcut_mapping_index);
+  session->private_data->shortcut_mapping_index = NULL;
   girara_list_free(session->config.shortcut_mappings);
   session->config.shortcut_mappings = NULL;
 
   /* clean up argument mappings */
+  girara_map_free(session->private_data->argument_mapping_index);
+  session->private_data->argument_mapping_index = NULL;
   girara_list_free(session->config.argument_mappings);
   session->config.argument_mappings = NULL;
 
   /* clean up modes */
+  girara_map_free(session->private_data->mode_index);
+  session->private_data->mode_index = NULL;
   girara_list_free(session->modes.identifiers);
   session->modes.identifiers = NULL;
 
@@ -610,6 +778,180 @@ girara_session_destroy(girara_session_t* session)
   return TRUE;
 }
 
+void*
+girara_session_alloc(girara_session_t* session,
+    girara_memory_category_t category, size_t size)
+{
+  girara_arena_t* arena = session->private_data->arena;
+  if (arena == NULL) {
+    return g_slice_alloc0(size);
+  }
+
+  girara_memory_stats_t* stats = &session->private_data->memory_stats[category];
+  stats->objects += 1;
+  stats->bytes   += size;
+
+  return girara_arena_alloc(arena, size);
+}
+
+char*
+girara_session_strdup(girara_session_t* session,
+    girara_memory_category_t category, const char* str)
+{
+  girara_arena_t* arena = session->private_data->arena;
+  if (arena == NULL || str == NULL) {
+    return g_strdup(str);
+  }
+
+  session->private_data->memory_stats[category].bytes += strlen(str) + 1;
+
+  return girara_arena_strdup(arena, str);
+}
+
+void
+girara_session_strfree(girara_session_t* session, char* str)
+{
+  if (session->private_data->arena == NULL) {
+    g_free(str);
+  }
+}
+
+bool
+girara_session_get_memory_stats(girara_session_t* session,
+    girara_memory_category_t category, girara_memory_stats_t* stats)
+{
+  g_return_val_if_fail(session != NULL, false);
+  g_return_val_if_fail(category < GIRARA_MEMORY_CATEGORY_COUNT, false);
+  g_return_val_if_fail(stats != NULL, false);
+
+  if (session->private_data->arena == NULL) {
+    return false;
+  }
+
+  *stats = session->private_data->memory_stats[category];
+  return true;
+}
+
+bool
+girara_session_is_headless(girara_session_t* session)
+{
+  g_return_val_if_fail(session != NULL, false);
+
+  return session->private_data->headless;
+}
+
+/* The following widgets are only created once they are needed. Widgets that
+ * are created before girara_session_init are packed by it, later ones are
+ * packed right away. */
+
+GtkWidget*
+girara_session_get_notification_area(girara_session_t* session)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+
+  if (session->gtk.notification_area != NULL || session->private_data->headless == true) {
+    return session->gtk.notification_area;
+  }
+
+  session->gtk.notification_area = gtk_event_box_new();
+  session->gtk.notification_text = gtk_label_new(NULL);
+
+  gtk_container_add(GTK_CONTAINER(session->gtk.notification_area), session->gtk.notification_text);
+  gtk_misc_set_alignment(GTK_MISC(session->gtk.notification_text), 0.0, 0.5);
+  gtk_label_set_use_markup(GTK_LABEL(session->gtk.notification_text), TRUE);
+  gtk_widget_set_name(session->gtk.notification_text, "bottom_box");
+
+  widget_add_class(session->gtk.notification_area, "notification");
+  widget_add_class(session->gtk.notification_text, "notification");
+  gtk_style_context_save(gtk_widget_get_style_context(session->gtk.notification_area));
+  gtk_style_context_save(gtk_widget_get_style_context(session->gtk.notification_text));
+
+  /* the area itself is only shown by girara_notify */
+  gtk_widget_show(session->gtk.notification_text);
+
+  if (session->private_data->initialized == true) {
+    notification_area_pack(session);
+  }
+
+  return session->gtk.notification_area;
+}
+
+GtkWidget*
+girara_session_get_notification_text(girara_session_t* session)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+
+  girara_session_get_notification_area(session);
+  return session->gtk.notification_text;
+}
+
+GtkLabel*
+girara_session_get_inputbar_dialog(girara_session_t* session)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+
+  if (session->gtk.inputbar_dialog != NULL || session->private_data->headless == true) {
+    return session->gtk.inputbar_dialog;
+  }
+
+  session->gtk.inputbar_dialog = GTK_LABEL(gtk_label_new(NULL));
+  widget_add_class(GTK_WIDGET(session->gtk.inputbar_dialog), "inputbar");
+
+  if (session->private_data->initialized == true) {
+    inputbar_dialog_pack(session);
+  }
+
+  return session->gtk.inputbar_dialog;
+}
+
+GtkWidget*
+girara_session_get_tabbar(girara_session_t* session)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+
+  if (session->gtk.tabbar != NULL || session->private_data->headless == true) {
+    return session->gtk.tabbar;
+  }
+
+  session->gtk.tabbar = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 0);
+  gtk_box_set_homogeneous(GTK_BOX(session->gtk.tabbar), TRUE);
+
+  if (session->private_data->initialized == true) {
+    tabbar_pack(session);
+    gtk_widget_show(session->gtk.tabbar);
+  }
+
+  return session->gtk.tabbar;
+}
+
+GtkNotebook*
+girara_session_get_tabs(girara_session_t* session)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+
+  if (session->gtk.tabs != NULL || session->private_data->headless == true) {
+    return session->gtk.tabs;
+  }
+
+  session->gtk.tabs = GTK_NOTEBOOK(gtk_notebook_new());
+  gtk_notebook_set_show_border(session->gtk.tabs, FALSE);
+  gtk_notebook_set_show_tabs(session->gtk.tabs,   FALSE);
+
+  return session->gtk.tabs;
+}
+
+size_t
+girara_session_get_arena_size(girara_session_t* session)
+{
+  g_return_val_if_fail(session != NULL, 0);
+
+  if (session->private_data->arena == NULL) {
+    return 0;
+  }
+
+  return girara_arena_get_size(session->private_data->arena);
+}
+
 char*
 girara_buffer_get(girara_session_t* session)
 {
@@ -680,11 +1022,21 @@ girara_libnotify(girara_session_t* session, const char *summary,
 void
 girara_notify(girara_session_t* session, int level, const char* format, ...)
 {
+  if (session != NULL && session->private_data->headless == true) {
+    va_list ap;
+    va_start(ap, format);
+    char* message = g_strdup_vprintf(format, ap);
+    va_end(ap);
+
+    _girara_debug(__FUNCTION__, __LINE__, level, "%s", message);
+    g_free(message);
+    return;
+  }
+
   if (session == NULL
-      || session->gtk.notification_text == NULL
-      || session->gtk.notification_area == NULL
       || session->gtk.inputbar == NULL
-      || session->gtk.view == NULL) {
+      || session->gtk.view == NULL
+      || girara_session_get_notification_area(session) == NULL) {
     return;
   }
 
@@ -737,8 +1089,8 @@ girara_dialog(girara_session_t* session, const char* dialog, bool
     girara_callback_inputbar_activate_t activate_event, void* data)
 {
   if (session == NULL || session->gtk.inputbar == NULL
-      || session->gtk.inputbar_dialog == NULL
-      || session->gtk.inputbar_entry == NULL) {
+      || session->gtk.inputbar_entry == NULL
+      || girara_session_get_inputbar_dialog(session) == NULL) {
     return;
   }
 
@@ -770,6 +1122,10 @@ girara_set_view(girara_session_t* session, GtkWidget* widget)
 {
   g_return_val_if_fail(session != NULL, false);
 
+  if (session->gtk.viewport == NULL) {
+    return false;
+  }
+
   GtkWidget* child = gtk_bin_get_child(GTK_BIN(session->gtk.viewport));
 
   if (child != NULL) {
@@ -798,19 +1154,18 @@ girara_mode_add(girara_session_t* session, const char* name)
   g_return_val_if_fail(session  != NULL, FALSE);
   g_return_val_if_fail(name != NULL && name[0] != '\0', FALSE);
 
-  girara_mode_t last_index = 0;
-  GIRARA_LIST_FOREACH(session->modes.identifiers, girara_mode_string_t*, iter, mode)
-    if (mode->index > last_index) {
-      last_index = mode->index;
-    }
-  GIRARA_LIST_FOREACH_END(session->modes.identifiers, girara_mode_string_t*, iter, mode);
-
   /* create new mode identifier */
-  girara_mode_string_t* mode = g_slice_new(girara_mode_string_t);
-  mode->index = last_index + 1;
-  mode->name = g_strdup(name);
+  girara_mode_string_t* mode = girara_session_alloc(session,
+      GIRARA_MEMORY_MODES, sizeof(girara_mode_string_t));
+  mode->index = ++session->private_data->last_mode;
+  mode->name = girara_session_strdup(session, GIRARA_MEMORY_MODES, name);
   girara_list_append(session->modes.identifiers, mode);
 
+  /* the first mode of a name is the one used by map */
+  if (girara_map_get(session->private_data->mode_index, mode->name) == NULL) {
+    girara_map_set(session->private_data->mode_index, mode->name, mode);
+  }
+
   return mode->index;
 }
 
@@ -21,14 +21,14 @@ struct girara_session_s
     GtkWidget       *viewport; /**< The viewport of view */
     GtkWidget       *statusbar; /**< The statusbar */
     GtkBox          *statusbar_entries; /**< Statusbar entry box */
-    GtkWidget       *notification_area; /**< The notification area */
-    GtkWidget       *notification_text; /**< The notification entry */
-    GtkWidget       *tabbar; /**< The tabbar */
+    GtkWidget       *notification_area; /**< The notification area, NULL until created by girara_session_get_notification_area */
+    GtkWidget       *notification_text; /**< The notification entry, NULL until created by girara_session_get_notification_text */
+    GtkWidget       *tabbar; /**< The tabbar, NULL until created by girara_session_get_tabbar */
     GtkBox          *inputbar_box; /**< Inputbar box */
     GtkWidget       *inputbar; /**< Inputbar event box */
-    GtkLabel        *inputbar_dialog; /**< Inputbar dialog */
+    GtkLabel        *inputbar_dialog; /**< Inputbar dialog, NULL until created by girara_session_get_inputbar_dialog */
     GtkEntry        *inputbar_entry; /**< Inputbar entry */
-    GtkNotebook     *tabs; /**< The tabs notebook */
+    GtkNotebook     *tabs; /**< The tabs notebook, NULL until created by girara_session_get_tabs */
     GtkBox          *results; /**< Completion results */
     Window          embed; /**< Embedded window */
   } gtk;
@@ -142,6 +142,164 @@ struct girara_session_s
  */
 girara_session_t* girara_session_create();
 
+/**
+ * Flags for the creation of a girara session
+ */
+typedef enum girara_session_flags_e
+{
+  GIRARA_SESSION_DEFAULT = 0, /**< Default behaviour */
+  GIRARA_SESSION_ARENA = 1 << 0, /**< Allocate shortcuts, commands, mouse
+                                    events, settings, config handles, mappings
+                                    and modes from an arena that is released at
+                                    once in girara_session_destroy */
+  GIRARA_SESSION_HEADLESS = 1 << 1 /**< Do not create any widgets. Settings,
+                                      bindings, config files, commands and the
+                                      command history work without a display;
+                                      notifications are logged instead */
+} girara_session_flags_t;
+
+/**
+ * Creates a girara session
+ *
+ * @param flags Combination of girara_session_flags_t values
+ * @return A valid session object
+ * @return NULL when an error occured
+ */
+girara_session_t* girara_session_create2(girara_session_flags_t flags);
+
+/**
+ * Returns whether the session was created with GIRARA_SESSION_HEADLESS
+ *
+ * @param session The used girara session
+ * @return true if the session has no widgets
+ */
+bool girara_session_is_headless(girara_session_t* session);
+
+/**
+ * Returns the notification area. It is created on first use, so
+ * session->gtk.notification_area is NULL until then.
+ *
+ * @param session The used girara session
+ * @return The notification area or NULL for headless sessions
+ */
+GtkWidget* girara_session_get_notification_area(girara_session_t* session);
+
+/**
+ * Returns the label of the notification area. It is created together with
+ * the notification area.
+ *
+ * @param session The used girara session
+ * @return The label or NULL for headless sessions
+ */
+GtkWidget* girara_session_get_notification_text(girara_session_t* session);
+
+/**
+ * Returns the inputbar dialog label. It is created on first use, e.g. by
+ * girara_dialog.
+ *
+ * @param session The used girara session
+ * @return The label or NULL for headless sessions
+ */
+GtkLabel* girara_session_get_inputbar_dialog(girara_session_t* session);
+
+/**
+ * Returns the tab bar. It is created on first use, e.g. by
+ * girara_tabs_enable.
+ *
+ * @param session The used girara session
+ * @return The tab bar or NULL for headless sessions
+ */
+GtkWidget* girara_session_get_tabbar(girara_session_t* session);
+
+/**
+ * Returns the notebook holding the tabs. It is created on first use, e.g. by
+ * girara_tabs_enable.
+ *
+ * @param session The used girara session
+ * @return The notebook or NULL for headless sessions
+ */
+GtkNotebook* girara_session_get_tabs(girara_session_t* session);
+
+/**
+ * Returns the memory allocated for the registries of a session that was
+ * created with GIRARA_SESSION_ARENA. Memory of removed entries is only
+ * reclaimed once the session is destroyed and is therefore still included.
+ *
+ * @param session The used girara session
+ * @param category The category
+ * @param stats Location to store the statistics
+ * @return true if the session uses an arena, false otherwise
+ */
+bool girara_session_get_memory_stats(girara_session_t* session,
+    girara_memory_category_t category, girara_memory_stats_t* stats);
+
+/**
+ * Returns the total number of bytes reserved by the arena of a session
+ *
+ * @param session The used girara session
+ * @return Number of reserved bytes, 0 if the session does not use an arena
+ */
+size_t girara_session_get_arena_size(girara_session_t* session);
+
+/**
+ * Returns the latencies of the handlers run for an input source
+ *
+ * @param session The used girara session
+ * @param source The input source
+ * @param stats Location to store the statistics
+ * @return true No error occured
+ * @return false An error occured
+ */
+bool girara_session_get_latency_stats(girara_session_t* session,
+    girara_latency_source_t source, girara_latency_stats_t* stats);
+
+/**
+ * Returns the latencies of a binding. Bindings are named like in the
+ * :latency command, e.g. "gg", "<C-x>", "<Button1>", ":open" or
+ * "<special:/>" for the special command with the identifier '/'.
+ *
+ * @param session The used girara session
+ * @param binding Name of the binding
+ * @param stats Location to store the statistics
+ * @return true if the binding has been run, false otherwise
+ */
+bool girara_session_get_binding_latency_stats(girara_session_t* session,
+    const char* binding, girara_latency_stats_t* stats);
+
+/**
+ * Returns the names of all bindings that have been run
+ *
+ * @param session The used girara session
+ * @return Sorted list of binding names that has to be freed
+ */
+girara_list_t* girara_session_get_latency_bindings(girara_session_t* session);
+
+/**
+ * Returns the number of invocations and the CPU time of all shortcut
+ * functions, command functions and setting callbacks that have been run
+ *
+ * @param session The used girara session
+ * @return List of girara_profile_entry_t sorted by descending CPU time that
+ *   has to be freed
+ */
+girara_list_t* girara_session_get_profile(girara_session_t* session);
+
+/**
+ * Returns the profile of the session as text with one handler per line,
+ * sorted by descending CPU time
+ *
+ * @param session The used girara session
+ * @return The report that has to be freed with g_free
+ */
+char* girara_session_get_profile_report(girara_session_t* session);
+
+/**
+ * Resets the profile of the session
+ *
+ * @param session The used girara session
+ */
+void girara_session_reset_profile(girara_session_t* session);
+
 /**
  * Initializes an girara session
  *
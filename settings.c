@@ -56,7 +56,13 @@ girara_setting_set_value(girara_session_t* session, girara_setting_t* setting, v
   }
 
   if (session && setting->callback != NULL) {
+    girara_profile_entry_t* profile = girara_profile_setting(session,
+        setting->name);
+    const gint64 cpu_start = girara_profile_begin();
+
     setting->callback(session, setting->name, setting->type, value, setting->data);
+
+    girara_profile_end(profile, cpu_start);
   }
 }
 
@@ -76,17 +82,21 @@ girara_setting_add(girara_session_t* session, const char* name, void* value, gir
   }
 
   /* add new setting */
-  girara_setting_t* setting = g_slice_new0(girara_setting_t);
+  girara_setting_t* setting = girara_session_alloc(session,
+      GIRARA_MEMORY_SETTINGS, sizeof(girara_setting_t));
 
-  setting->name        = g_strdup(name);
+  setting->name        = girara_session_strdup(session, GIRARA_MEMORY_SETTINGS,
+      name);
   setting->type        = type;
   setting->init_only   = init_only;
-  setting->description = description ? g_strdup(description) : NULL;
+  setting->description = girara_session_strdup(session,
+      GIRARA_MEMORY_SETTINGS, description);
   setting->callback    = callback;
   setting->data        = data;
   girara_setting_set_value(NULL, setting, value);
 
   girara_list_append(session->private_data->settings, setting);
+  girara_map_set(session->private_data->setting_index, setting->name, setting);
 
   return true;
 }
@@ -164,21 +174,22 @@ girara_setting_free(girara_setting_t* setting)
   g_slice_free(girara_setting_t, setting);
 }
 
+void
+girara_setting_free_value(girara_setting_t* setting)
+{
+  /* string values change at runtime and are never part of the arena */
+  if (setting != NULL && setting->type == STRING) {
+    g_free(setting->value.s);
+  }
+}
+
 girara_setting_t*
 girara_setting_find(girara_session_t* session, const char* name)
 {
   g_return_val_if_fail(session != NULL, NULL);
   g_return_val_if_fail(name != NULL, NULL);
 
-  girara_setting_t* result = NULL;
-  GIRARA_LIST_FOREACH(session->private_data->settings, girara_setting_t*, iter, setting)
-    if (g_strcmp0(setting->name, name) == 0) {
-      result = setting;
-      break;
-    }
-  GIRARA_LIST_FOREACH_END(session->private_data->settings, girara_setting_t*, iter, setting);
-
-  return result;
+  return girara_map_get(session->private_data->setting_index, name);
 }
 
 const char*
@@ -213,12 +224,12 @@ girara_cc_set(girara_session_t* session, const char* input)
 
   unsigned int input_length = strlen(input);
 
-  GIRARA_LIST_FOREACH(session->private_data->settings, girara_setting_t*, iter, setting)
+  GIRARA_LIST_FOREACH_STACK(session->private_data->settings, girara_setting_t*, iter, setting)
     if ((setting->init_only == false) && (input_length <= strlen(setting->name)) &&
         !strncmp(input, setting->name, input_length)) {
       girara_completion_group_add_element(group, setting->name, setting->description);
     }
-  GIRARA_LIST_FOREACH_END(session->private_data->settings, girara_setting_t*, iter, setting);
+  GIRARA_LIST_FOREACH_STACK_END(session->private_data->settings, girara_setting_t*, iter, setting);
 
   return completion;
 }
@@ -7,6 +7,7 @@
 #include "settings.h"
 #include "tabs.h"
 #include "input-history.h"
+#include "utils.h"
 
 #include <string.h>
 #include <gtk/gtk.h>
@@ -21,8 +22,25 @@ girara_shortcut_add(girara_session_t* session, guint modifier, guint key, const
   g_return_val_if_fail(buffer || key || modifier, false);
   g_return_val_if_fail(function != NULL, false);
 
-  girara_argument_t argument = {argument_n, (argument_data != NULL) ?
-    g_strdup(argument_data) : NULL};
+  girara_argument_t argument = {argument_n, girara_session_strdup(session,
+    GIRARA_MEMORY_SHORTCUTS, argument_data)};
+
+  /* duplicates are resolved when the transaction is committed */
+  if (session->private_data->shortcut_transaction.depth != 0) {
+    girara_shortcut_t* shortcut = girara_session_alloc(session,
+        GIRARA_MEMORY_SHORTCUTS, sizeof(girara_shortcut_t));
+
+    shortcut->mask             = modifier;
+    shortcut->key              = key;
+    shortcut->buffered_command = girara_session_strdup(session,
+        GIRARA_MEMORY_SHORTCUTS, buffer);
+    shortcut->function         = function;
+    shortcut->mode             = mode;
+    shortcut->argument         = argument;
+    girara_list_append(session->private_data->shortcut_transaction.pending, shortcut);
+
+    return true;
+  }
 
   /* search for existing binding */
   bool found_existing_shortcut = false;
@@ -31,10 +49,13 @@ girara_shortcut_add(girara_session_t* session, guint modifier, guint key, const
        (buffer && shortcuts_it->buffered_command && !strcmp(shortcuts_it->buffered_command, buffer)))
         && ((shortcuts_it->mode == mode) || (mode == 0)))
     {
-      if (shortcuts_it->argument.data != NULL) {
-        g_free(shortcuts_it->argument.data);
-      }
+      girara_session_strfree(session, shortcuts_it->argument.data);
+      girara_key_sequence_unref(shortcuts_it->key_sequence);
+      shortcuts_it->key_sequence = NULL;
 
+      if (shortcuts_it->function != function) {
+        shortcuts_it->count_aware = false;
+      }
       shortcuts_it->function  = function;
       shortcuts_it->argument  = argument;
       found_existing_shortcut = true;
@@ -51,11 +72,13 @@ girara_shortcut_add(girara_session_t* session, guint modifier, guint key, const
   }
 
   /* add new shortcut */
-  girara_shortcut_t* shortcut = g_slice_new(girara_shortcut_t);
+  girara_shortcut_t* shortcut = girara_session_alloc(session,
+      GIRARA_MEMORY_SHORTCUTS, sizeof(girara_shortcut_t));
 
   shortcut->mask             = modifier;
   shortcut->key              = key;
-  shortcut->buffered_command = g_strdup(buffer);
+  shortcut->buffered_command = girara_session_strdup(session,
+      GIRARA_MEMORY_SHORTCUTS, buffer);
   shortcut->function         = function;
   shortcut->mode             = mode;
   shortcut->argument         = argument;
@@ -64,18 +87,208 @@ girara_shortcut_add(girara_session_t* session, guint modifier, guint key, const
   return true;
 }
 
+static void
+shortcut_discard(girara_session_t* session, girara_shortcut_t* shortcut)
+{
+  /* shortcuts of an arena are released with the session */
+  if (session->private_data->arena == NULL) {
+    girara_shortcut_free(shortcut);
+  }
+}
+
+static void
+shortcut_index_add(girara_map_t* index, const char* name,
+    girara_shortcut_t* shortcut)
+{
+  girara_list_t* bucket = girara_map_get(index, name);
+  if (bucket == NULL) {
+    bucket = girara_list_new();
+    girara_map_set(index, name, bucket);
+  }
+
+  girara_list_append(bucket, shortcut);
+}
+
+static char*
+shortcut_index_key_name(guint modifier, guint key)
+{
+  return g_strdup_printf("k%x:%x", modifier, key);
+}
+
+static char*
+shortcut_index_buffer_name(const char* buffer)
+{
+  return g_strconcat("b", buffer, NULL);
+}
+
+static void
+shortcut_index_insert(girara_map_t* index, girara_shortcut_t* shortcut)
+{
+  if (shortcut->mask != 0 || shortcut->key != 0) {
+    char* name = shortcut_index_key_name(shortcut->mask, shortcut->key);
+    shortcut_index_add(index, name, shortcut);
+    g_free(name);
+  }
+
+  if (shortcut->buffered_command != NULL) {
+    char* name = shortcut_index_buffer_name(shortcut->buffered_command);
+    shortcut_index_add(index, name, shortcut);
+    g_free(name);
+  }
+}
+
+static void
+shortcut_update(girara_session_t* session, girara_shortcut_t* shortcut,
+    const girara_shortcut_t* pending)
+{
+  girara_session_strfree(session, shortcut->argument.data);
+  girara_key_sequence_unref(shortcut->key_sequence);
+  shortcut->key_sequence = NULL;
+
+  if (shortcut->function != pending->function) {
+    shortcut->count_aware = false;
+  }
+  shortcut->function      = pending->function;
+  shortcut->argument.n    = pending->argument.n;
+  shortcut->argument.data = girara_session_strdup(session,
+      GIRARA_MEMORY_SHORTCUTS, pending->argument.data);
+}
+
+static bool
+shortcut_resolve(girara_session_t* session, girara_map_t* index,
+    const girara_shortcut_t* pending)
+{
+  const bool has_key = pending->mask != 0 || pending->key != 0;
+  bool found         = false;
+
+  girara_list_t* buckets[2] = { NULL, NULL };
+  if (has_key == true) {
+    char* name = shortcut_index_key_name(pending->mask, pending->key);
+    buckets[0] = girara_map_get(index, name);
+    g_free(name);
+  }
+  if (pending->buffered_command != NULL) {
+    char* name = shortcut_index_buffer_name(pending->buffered_command);
+    buckets[1] = girara_map_get(index, name);
+    g_free(name);
+  }
+
+  /* same rules as girara_shortcut_add: a mode of 0 replaces the binding in
+   * every mode, otherwise only the one of the given mode */
+  for (size_t i = 0; i < LENGTH(buckets); i++) {
+    if (buckets[i] == NULL) {
+      continue;
+    }
+
+    GIRARA_LIST_FOREACH_STACK(buckets[i], girara_shortcut_t*, iter, shortcut)
+      /* shortcuts matching both ways have been handled with the key */
+      const bool handled = i == 1 && has_key == true &&
+        shortcut->mask == pending->mask && shortcut->key == pending->key;
+
+      if (handled == false && (pending->mode == 0 || shortcut->mode == pending->mode)) {
+        shortcut_update(session, shortcut, pending);
+        found = true;
+
+        if (pending->mode != 0) {
+          return true;
+        }
+      }
+    GIRARA_LIST_FOREACH_STACK_END(buckets[i], girara_shortcut_t*, iter, shortcut);
+  }
+
+  return found;
+}
+
+static void
+shortcut_transaction_flush(girara_session_t* session)
+{
+  girara_list_t* pending = session->private_data->shortcut_transaction.pending;
+  if (pending == NULL || girara_list_size(pending) == 0) {
+    return;
+  }
+
+  /* index the existing shortcuts once instead of searching them for every
+   * added shortcut */
+  girara_map_t* index = girara_map_new2((girara_free_function_t) girara_list_free);
+  GIRARA_LIST_FOREACH_STACK(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut)
+    shortcut_index_insert(index, shortcut);
+  GIRARA_LIST_FOREACH_STACK_END(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut);
+
+  GIRARA_LIST_FOREACH_STACK(pending, girara_shortcut_t*, iter, shortcut)
+    if (shortcut_resolve(session, index, shortcut) == true) {
+      shortcut_discard(session, shortcut);
+    } else {
+      girara_list_append(session->bindings.shortcuts, shortcut);
+      shortcut_index_insert(index, shortcut);
+    }
+  GIRARA_LIST_FOREACH_STACK_END(pending, girara_shortcut_t*, iter, shortcut);
+
+  girara_map_free(index);
+  girara_list_clear(pending);
+}
+
+void
+girara_shortcut_transaction_begin(girara_session_t* session)
+{
+  g_return_if_fail(session != NULL);
+
+  if (session->private_data->shortcut_transaction.pending == NULL) {
+    session->private_data->shortcut_transaction.pending = girara_list_new();
+  }
+
+  session->private_data->shortcut_transaction.depth++;
+}
+
+void
+girara_shortcut_transaction_commit(girara_session_t* session)
+{
+  g_return_if_fail(session != NULL);
+  g_return_if_fail(session->private_data->shortcut_transaction.depth != 0);
+
+  if (--session->private_data->shortcut_transaction.depth == 0) {
+    shortcut_transaction_flush(session);
+  }
+}
+
+void
+girara_shortcut_transaction_free(girara_session_t* session)
+{
+  g_return_if_fail(session != NULL);
+
+  girara_list_t* pending = session->private_data->shortcut_transaction.pending;
+  if (pending == NULL) {
+    return;
+  }
+
+  /* shortcuts of transactions that have never been committed */
+  GIRARA_LIST_FOREACH_STACK(pending, girara_shortcut_t*, iter, shortcut)
+    shortcut_discard(session, shortcut);
+  GIRARA_LIST_FOREACH_STACK_END(pending, girara_shortcut_t*, iter, shortcut);
+
+  girara_list_free(pending);
+  session->private_data->shortcut_transaction.pending = NULL;
+  session->private_data->shortcut_transaction.depth   = 0;
+}
+
 bool
 girara_shortcut_remove(girara_session_t* session, guint modifier, guint key, const char* buffer, girara_mode_t mode)
 {
   g_return_val_if_fail(session != NULL, false);
   g_return_val_if_fail(buffer || key || modifier, false);
 
+  /* the shortcut might still be part of the transaction */
+  shortcut_transaction_flush(session);
+
   /* search for existing binding */
   GIRARA_LIST_FOREACH(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcuts_it)
     if (((shortcuts_it->mask == modifier && shortcuts_it->key == key && (modifier != 0 || key != 0)) ||
        (buffer && shortcuts_it->buffered_command && !strcmp(shortcuts_it->buffered_command, buffer)))
         && shortcuts_it->mode == mode)
     {
+      /* shortcuts of an arena are not freed by the list */
+      girara_key_sequence_unref(shortcuts_it->key_sequence);
+      shortcuts_it->key_sequence = NULL;
+
       girara_list_remove(session->bindings.shortcuts, shortcuts_it);
       girara_list_iterator_free(iter);
       return true;
@@ -85,15 +298,57 @@ girara_shortcut_remove(girara_session_t* session, guint modifier, guint key, con
   return false;
 }
 
+bool
+girara_shortcut_set_count_aware(girara_session_t* session, guint modifier,
+    guint key, const char* buffer, girara_mode_t mode, bool count_aware)
+{
+  g_return_val_if_fail(session != NULL, false);
+  g_return_val_if_fail(buffer || key || modifier, false);
+
+  /* the shortcut might still be part of the transaction */
+  shortcut_transaction_flush(session);
+
+  GIRARA_LIST_FOREACH_STACK(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcuts_it)
+    if (((shortcuts_it->mask == modifier && shortcuts_it->key == key && (modifier != 0 || key != 0)) ||
+       (buffer && shortcuts_it->buffered_command && !strcmp(shortcuts_it->buffered_command, buffer)))
+        && shortcuts_it->mode == mode)
+    {
+      shortcuts_it->count_aware = count_aware;
+      return true;
+    }
+  GIRARA_LIST_FOREACH_STACK_END(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcuts_it);
+
+  return false;
+}
+
 void
 girara_shortcut_free(girara_shortcut_t* shortcut)
 {
   g_return_if_fail(shortcut != NULL);
   g_free(shortcut->buffered_command);
   g_free(shortcut->argument.data);
+  girara_key_sequence_unref(shortcut->key_sequence);
   g_slice_free(girara_shortcut_t, shortcut);
 }
 
+girara_inputbar_shortcut_t*
+girara_inputbar_shortcut_find(girara_session_t* session, guint modifier,
+    guint key)
+{
+  girara_list_t* bucket = girara_int_map_get(session->private_data->inputbar_shortcut_index, key);
+  if (bucket == NULL) {
+    return NULL;
+  }
+
+  GIRARA_LIST_FOREACH_STACK(bucket, girara_inputbar_shortcut_t*, iter, inputbar_shortcut)
+    if (inputbar_shortcut->mask == modifier) {
+      return inputbar_shortcut;
+    }
+  GIRARA_LIST_FOREACH_STACK_END(bucket, girara_inputbar_shortcut_t*, iter, inputbar_shortcut);
+
+  return NULL;
+}
+
 bool
 girara_inputbar_shortcut_add(girara_session_t* session, guint modifier, guint key, girara_shortcut_function_t function, int argument_n, void* argument_data)
 {
@@ -102,19 +357,17 @@ girara_inputbar_shortcut_add(girara_session_t* session, guint modifier, guint ke
 
   girara_argument_t argument = {argument_n, argument_data};
 
-  /* search for existing special command */
-  GIRARA_LIST_FOREACH(session->bindings.inputbar_shortcuts, girara_inputbar_shortcut_t*, iter, inp_sh_it)
-    if (inp_sh_it->mask == modifier && inp_sh_it->key == key) {
-      inp_sh_it->function = function;
-      inp_sh_it->argument = argument;
-
-      girara_list_iterator_free(iter);
-      return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->bindings.inputbar_shortcuts, girara_inputbar_shortcut_t*, iter, inp_sh_it);
+  /* search for existing inputbar shortcut */
+  girara_inputbar_shortcut_t* inp_sh_it = girara_inputbar_shortcut_find(session, modifier, key);
+  if (inp_sh_it != NULL) {
+    inp_sh_it->function = function;
+    inp_sh_it->argument = argument;
+    return true;
+  }
 
   /* create new inputbar shortcut */
-  girara_inputbar_shortcut_t* inputbar_shortcut = g_slice_new(girara_inputbar_shortcut_t);
+  girara_inputbar_shortcut_t* inputbar_shortcut = girara_session_alloc(session,
+      GIRARA_MEMORY_SHORTCUTS, sizeof(girara_inputbar_shortcut_t));
 
   inputbar_shortcut->mask     = modifier;
   inputbar_shortcut->key      = key;
@@ -122,6 +375,14 @@ girara_inputbar_shortcut_add(girara_session_t* session, guint modifier, guint ke
   inputbar_shortcut->argument = argument;
 
   girara_list_append(session->bindings.inputbar_shortcuts, inputbar_shortcut);
+
+  girara_list_t* bucket = girara_int_map_get(session->private_data->inputbar_shortcut_index, key);
+  if (bucket == NULL) {
+    bucket = girara_list_new();
+    girara_int_map_set(session->private_data->inputbar_shortcut_index, key, bucket);
+  }
+  girara_list_append(bucket, inputbar_shortcut);
+
   return true;
 }
 
@@ -130,14 +391,17 @@ girara_inputbar_shortcut_remove(girara_session_t* session, guint modifier, guint
 {
   g_return_val_if_fail(session  != NULL, false);
 
-  /* search for existing special command */
-  GIRARA_LIST_FOREACH(session->bindings.inputbar_shortcuts, girara_inputbar_shortcut_t*, iter, inp_sh_it)
-    if (inp_sh_it->mask == modifier && inp_sh_it->key == key) {
-      girara_list_remove(session->bindings.inputbar_shortcuts, inp_sh_it);
-      girara_list_iterator_free(iter);
-      return true;
+  /* search for existing inputbar shortcut */
+  girara_inputbar_shortcut_t* inp_sh_it = girara_inputbar_shortcut_find(session, modifier, key);
+  if (inp_sh_it != NULL) {
+    girara_list_t* bucket = girara_int_map_get(session->private_data->inputbar_shortcut_index, key);
+    girara_list_remove(bucket, inp_sh_it);
+    if (girara_list_size(bucket) == 0) {
+      girara_int_map_remove(session->private_data->inputbar_shortcut_index, key);
     }
-  GIRARA_LIST_FOREACH_END(session->bindings.inputbar_shortcuts, girara_inputbar_shortcut_t*, iter, inp_sh_it);
+
+    girara_list_remove(session->bindings.inputbar_shortcuts, inp_sh_it);
+  }
 
   return true;
 }
@@ -153,6 +417,11 @@ girara_isc_abort(girara_session_t* session, girara_argument_t* UNUSED(argument),
 {
   g_return_val_if_fail(session != NULL, false);
 
+  /* headless sessions have no inputbar */
+  if (session->gtk.inputbar_entry == NULL) {
+    return false;
+  }
+
   /* hide completion */
   girara_argument_t arg = { GIRARA_HIDE, NULL };
   girara_isc_completion(session, &arg, NULL, 0);
@@ -164,7 +433,9 @@ girara_isc_abort(girara_session_t* session, girara_argument_t* UNUSED(argument),
   gtk_widget_grab_focus(GTK_WIDGET(session->gtk.view));
 
   /* hide inputbar */
-  gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar_dialog));
+  if (session->gtk.inputbar_dialog != NULL) {
+    gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar_dialog));
+  }
   if (session->global.autohide_inputbar == true) {
     gtk_widget_hide(GTK_WIDGET(session->gtk.inputbar));
   }
@@ -185,6 +456,11 @@ girara_isc_string_manipulation(girara_session_t* session, girara_argument_t* arg
 {
   g_return_val_if_fail(session != NULL, false);
 
+  /* headless sessions have no inputbar */
+  if (session->gtk.inputbar_entry == NULL) {
+    return false;
+  }
+
   gchar *separator = NULL;
   girara_setting_get(session, "word-separator", &separator);
   gchar *input  = gtk_editable_get_chars(GTK_EDITABLE(session->gtk.inputbar_entry), 0, -1);
@@ -264,6 +540,11 @@ girara_isc_command_history(girara_session_t* session, girara_argument_t*
 {
   g_return_val_if_fail(session != NULL, false);
 
+  /* headless sessions have no inputbar */
+  if (session->gtk.inputbar_entry == NULL) {
+    return false;
+  }
+
   char* temp = gtk_editable_get_chars(GTK_EDITABLE(session->gtk.inputbar_entry), 0, -1);
   const char* command = argument->n == GIRARA_NEXT ?
     girara_input_history_next(session->command_history, temp) :
@@ -290,7 +571,8 @@ girara_sc_focus_inputbar(girara_session_t* session, girara_argument_t* argument,
     gtk_widget_show(GTK_WIDGET(session->gtk.inputbar));
   }
 
-  if (gtk_widget_get_visible(GTK_WIDGET(session->gtk.notification_area)) == true) {
+  if (session->gtk.notification_area != NULL &&
+      gtk_widget_get_visible(GTK_WIDGET(session->gtk.notification_area)) == true) {
     gtk_widget_hide(GTK_WIDGET(session->gtk.notification_area));
   }
 
@@ -319,9 +601,13 @@ girara_sc_abort(girara_session_t* session, girara_argument_t* UNUSED(argument),
 {
   g_return_val_if_fail(session != NULL, false);
 
-  girara_isc_abort(session, NULL, NULL, 0);
+  if (girara_isc_abort(session, NULL, NULL, 0) == false) {
+    return false;
+  }
 
-  gtk_widget_hide(GTK_WIDGET(session->gtk.notification_area));
+  if (session->gtk.notification_area != NULL) {
+    gtk_widget_hide(GTK_WIDGET(session->gtk.notification_area));
+  }
 
   if (session->global.autohide_inputbar == false) {
     gtk_widget_show(GTK_WIDGET(session->gtk.inputbar));
@@ -338,7 +624,10 @@ girara_sc_quit(girara_session_t* session, girara_argument_t* UNUSED(argument), g
   girara_argument_t arg = { GIRARA_HIDE, NULL };
   girara_isc_completion(session, &arg, NULL, 0);
 
-  gtk_main_quit();
+  /* headless sessions may not run a GTK main loop */
+  if (gtk_main_level() != 0) {
+    gtk_main_quit();
+  }
 
   return false;
 }
@@ -486,69 +775,125 @@ girara_sc_set(girara_session_t* session, girara_argument_t* argument, girara_eve
   return false;
 }
 
-bool
-girara_sc_feedkeys(girara_session_t* session, girara_argument_t* argument,
-    girara_event_t* UNUSED(event), unsigned int t)
+static const girara_special_name_t special_names[] = {
+  /* keys */
+  {"BackSpace", GIRARA_SPECIAL_NAME_KEY, GDK_KEY_BackSpace},
+  {"CapsLock",  GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Caps_Lock},
+  {"Down",      GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Down},
+  {"Esc",       GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Escape},
+  {"F10",       GIRARA_SPECIAL_NAME_KEY, GDK_KEY_F10},
+  {"F11",       GIRARA_SPECIAL_NAME_KEY, GDK_KEY_F11},
+  {"F12",       GIRARA_SPECIAL_NAME_KEY, GDK_KEY_F12},
+  {"F1",        GIRARA_SPECIAL_NAME_KEY, GDK_KEY_F1},
+  {"F2",        GIRARA_SPECIAL_NAME_KEY, GDK_KEY_F2},
+  {"F3",        GIRARA_SPECIAL_NAME_KEY, GDK_KEY_F3},
+  {"F4",        GIRARA_SPECIAL_NAME_KEY, GDK_KEY_F4},
+  {"F5",        GIRARA_SPECIAL_NAME_KEY, GDK_KEY_F5},
+  {"F6",        GIRARA_SPECIAL_NAME_KEY, GDK_KEY_F6},
+  {"F7",        GIRARA_SPECIAL_NAME_KEY, GDK_KEY_F7},
+  {"F8",        GIRARA_SPECIAL_NAME_KEY, GDK_KEY_F8},
+  {"F9",        GIRARA_SPECIAL_NAME_KEY, GDK_KEY_F9},
+  {"Left",      GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Left},
+  {"PageDown",  GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Page_Down},
+  {"PageUp",    GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Page_Up},
+  {"Home",      GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Home},
+  {"End",       GIRARA_SPECIAL_NAME_KEY, GDK_KEY_End},
+  {"Return",    GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Return},
+  {"Right",     GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Right},
+  {"Space",     GIRARA_SPECIAL_NAME_KEY, GDK_KEY_space},
+  {"Super",     GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Super_L},
+  {"Tab",       GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Tab},
+  {"ShiftTab",  GIRARA_SPECIAL_NAME_KEY, GDK_KEY_ISO_Left_Tab},
+  {"Up",        GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Up},
+  {"Print",     GIRARA_SPECIAL_NAME_KEY, GDK_KEY_Print},
+  /* mouse buttons */
+  {"Button1",   GIRARA_SPECIAL_NAME_BUTTON, GIRARA_MOUSE_BUTTON1},
+  {"Button2",   GIRARA_SPECIAL_NAME_BUTTON, GIRARA_MOUSE_BUTTON2},
+  {"Button3",   GIRARA_SPECIAL_NAME_BUTTON, GIRARA_MOUSE_BUTTON3},
+  {"Button4",   GIRARA_SPECIAL_NAME_BUTTON, GIRARA_MOUSE_BUTTON4},
+  {"Button5",   GIRARA_SPECIAL_NAME_BUTTON, GIRARA_MOUSE_BUTTON5},
+  {"Button6",   GIRARA_SPECIAL_NAME_BUTTON, GIRARA_MOUSE_BUTTON6},
+  {"Button7",   GIRARA_SPECIAL_NAME_BUTTON, GIRARA_MOUSE_BUTTON7},
+  {"Button8",   GIRARA_SPECIAL_NAME_BUTTON, GIRARA_MOUSE_BUTTON8},
+  {"Button9",   GIRARA_SPECIAL_NAME_BUTTON, GIRARA_MOUSE_BUTTON9},
+  /* events without a button */
+  {"motion",        GIRARA_SPECIAL_NAME_EVENT, GIRARA_EVENT_MOTION_NOTIFY},
+  {"scroll_up",     GIRARA_SPECIAL_NAME_EVENT, GIRARA_EVENT_SCROLL_UP},
+  {"scroll_down",   GIRARA_SPECIAL_NAME_EVENT, GIRARA_EVENT_SCROLL_DOWN},
+  {"scroll_left",   GIRARA_SPECIAL_NAME_EVENT, GIRARA_EVENT_SCROLL_LEFT},
+  {"scroll_right",  GIRARA_SPECIAL_NAME_EVENT, GIRARA_EVENT_SCROLL_RIGHT},
+  {"scroll_smooth", GIRARA_SPECIAL_NAME_EVENT, GIRARA_EVENT_SCROLL_BIDIRECTIONAL},
+  /* button events */
+  {"button-pressed",   GIRARA_SPECIAL_NAME_BUTTON_EVENT, GIRARA_EVENT_BUTTON_PRESS},
+  {"2-button-pressed", GIRARA_SPECIAL_NAME_BUTTON_EVENT, GIRARA_EVENT_2BUTTON_PRESS},
+  {"3-button-pressed", GIRARA_SPECIAL_NAME_BUTTON_EVENT, GIRARA_EVENT_2BUTTON_PRESS},
+  {"button-released",  GIRARA_SPECIAL_NAME_BUTTON_EVENT, GIRARA_EVENT_BUTTON_RELEASE}
+};
+
+const girara_special_name_t*
+girara_special_name_find(const char* name)
+{
+  static gsize initialized = 0;
+  static GHashTable* names = NULL;
+
+  g_return_val_if_fail(name != NULL, NULL);
+
+  /* the table is hashed once for all sessions */
+  if (g_once_init_enter(&initialized)) {
+    names = g_hash_table_new(g_str_hash, g_str_equal);
+    for (size_t i = 0; i < LENGTH(special_names); i++) {
+      g_hash_table_insert(names, (gpointer) special_names[i].identifier,
+          (gpointer) &special_names[i]);
+    }
+    g_once_init_leave(&initialized, 1);
+  }
+
+  return g_hash_table_lookup(names, name);
+}
+
+static bool
+keyboard_button_find(const char* name, size_t length, guint* keyval)
 {
-  if (session == NULL || argument == NULL) {
+  /* longer names are not in the table anyway */
+  char buffer[32];
+  if (length >= sizeof(buffer)) {
     return false;
   }
 
-  typedef struct gdk_keyboard_button_s {
-    char* identifier;
-    int keyval;
-  } gdk_keyboard_button_t;
-
-  static const gdk_keyboard_button_t gdk_keyboard_buttons[] = {
-    {"BackSpace", GDK_KEY_BackSpace},
-    {"CapsLock",  GDK_KEY_Caps_Lock},
-    {"Down",      GDK_KEY_Down},
-    {"Esc",       GDK_KEY_Escape},
-    {"F10",       GDK_KEY_F10},
-    {"F11",       GDK_KEY_F11},
-    {"F12",       GDK_KEY_F12},
-    {"F1",        GDK_KEY_F1},
-    {"F2",        GDK_KEY_F2},
-    {"F3",        GDK_KEY_F3},
-    {"F4",        GDK_KEY_F4},
-    {"F5",        GDK_KEY_F5},
-    {"F6",        GDK_KEY_F6},
-    {"F7",        GDK_KEY_F7},
-    {"F8",        GDK_KEY_F8},
-    {"F9",        GDK_KEY_F9},
-    {"Left",      GDK_KEY_Left},
-    {"PageDown",  GDK_KEY_Page_Down},
-    {"PageUp",    GDK_KEY_Page_Up},
-    {"Home",      GDK_KEY_Home},
-    {"End",       GDK_KEY_End},
-    {"Return",    GDK_KEY_Return},
-    {"Right",     GDK_KEY_Right},
-    {"Space",     GDK_KEY_space},
-    {"Super",     GDK_KEY_Super_L},
-    {"Tab",       GDK_KEY_Tab},
-    {"ShiftTab",  GDK_KEY_ISO_Left_Tab},
-    {"Up",        GDK_KEY_Up}
-  };
+  memcpy(buffer, name, length);
+  buffer[length] = '\0';
 
-  char* input               = (char*) argument->data;
-  unsigned int input_length = strlen(input);
+  const girara_special_name_t* special = girara_special_name_find(buffer);
+  if (special == NULL || special->type != GIRARA_SPECIAL_NAME_KEY) {
+    return false;
+  }
 
-  t = (t == 0) ? 1 : t;
-  for (unsigned int c = 0; c < t; c++) {
-    for (unsigned i = 0; i < input_length; i++) {
-      int state  = 0;
-      int keyval = input[i];
-
-      /* possible special button */
-      if ((input_length - i) >= 3 && input[i] == '<') {
-        char* end = strchr(input + i, '>');
-        if (end == NULL) {
-          goto single_key;
-        }
+  *keyval = special->value;
+  return true;
+}
 
-        int length = end - (input + i) - 1;
-        char* tmp  = g_strndup(input + i + 1, length);
-        bool found = false;
+static girara_key_sequence_t*
+key_sequence_parse(const char* input)
+{
+  const size_t input_length = strlen(input);
+
+  /* every character yields at most one key */
+  girara_key_sequence_t* sequence = g_malloc(sizeof(girara_key_sequence_t) +
+      input_length * sizeof(girara_key_t));
+  sequence->refs   = 1;
+  sequence->length = 0;
+
+  for (size_t i = 0; i < input_length; i++) {
+    guint state  = 0;
+    guint keyval = input[i];
+
+    /* possible special button */
+    if ((input_length - i) >= 3 && input[i] == '<') {
+      const char* end = strchr(input + i, '>');
+      if (end != NULL) {
+        const char* tmp     = input + i + 1;
+        const size_t length = end - tmp;
+        bool found          = false;
 
         /* Multi key shortcut */
         if (length > 2 && tmp[1] == '-') {
@@ -570,43 +915,245 @@ girara_sc_feedkeys(girara_session_t* session, girara_argument_t* argument,
             keyval = tmp[2];
             found  = true;
           } else {
-            for (unsigned int i = 0; i < LENGTH(gdk_keyboard_buttons); i++) {
-              if (g_strcmp0(tmp + 2, gdk_keyboard_buttons[i].identifier) == 0) {
-                keyval = gdk_keyboard_buttons[i].keyval;
-                found = true;
-                break;
-              }
-            }
+            found = keyboard_button_find(tmp + 2, length - 2, &keyval);
           }
         /* Possible special key */
         } else {
-          for (unsigned int i = 0; i < LENGTH(gdk_keyboard_buttons); i++) {
-            if (g_strcmp0(tmp, gdk_keyboard_buttons[i].identifier) == 0) {
-              keyval = gdk_keyboard_buttons[i].keyval;
-              found = true;
-              break;
-            }
-          }
+          found = keyboard_button_find(tmp, length, &keyval);
         }
 
-        g_free(tmp);
-
         /* parsed special key */
         if (found == true) {
           i += length + 1;
         }
       }
+    }
+
+    sequence->keys[sequence->length].keyval = keyval;
+    sequence->keys[sequence->length].state  = state;
+    sequence->length++;
+  }
 
-single_key:
+  return sequence;
+}
+
+void
+girara_key_sequence_unref(girara_key_sequence_t* sequence)
+{
+  if (sequence != NULL && --sequence->refs == 0) {
+    g_free(sequence);
+  }
+}
+
+static void
+feed_key(girara_session_t* session, const girara_key_t* key)
+{
+  int state = key->state;
+  update_state_by_keyval(&state, key->keyval);
+
+  /* text typed into the inputbar has to go through GTK */
+  if (session->gtk.inputbar_entry != NULL &&
+      gtk_widget_is_focus(GTK_WIDGET(session->gtk.inputbar_entry)) == TRUE) {
+    simulate_key_press(session, state, key->keyval);
+    return;
+  }
+
+  if (girara_key_dispatch(session, key->keyval, key->state) == TRUE) {
+    return;
+  }
+
+  /* keys without a binding reach the key bindings of GTK and the handlers of
+   * the application, but are not dispatched by the view a second time */
+  session->private_data->feedkeys.passthrough++;
+  if (simulate_key_press(session, state, key->keyval) == false) {
+    session->private_data->feedkeys.passthrough--;
+  }
+}
+
+bool
+girara_sc_feedkeys(girara_session_t* session, girara_argument_t* argument,
+    girara_event_t* UNUSED(event), unsigned int t)
+{
+  if (session == NULL || argument == NULL || argument->data == NULL) {
+    return false;
+  }
+
+  /* the argument of a shortcut is parsed once and kept with the shortcut */
+  girara_shortcut_t* shortcut     = session->private_data->feedkeys.shortcut;
+  girara_key_sequence_t* sequence = NULL;
+  if (shortcut != NULL && argument == &shortcut->argument) {
+    if (shortcut->key_sequence == NULL) {
+      shortcut->key_sequence = key_sequence_parse(argument->data);
+    }
+    sequence = shortcut->key_sequence;
+    /* fed keys might rebind the shortcut */
+    sequence->refs++;
+  } else {
+    sequence = key_sequence_parse(argument->data);
+  }
+
+  /* only the key that triggered feedkeys ends up in a recorded macro */
+  session->private_data->feedkeys.depth++;
+  /* fed keys are not caused by an event */
+  const guint32 event_time = session->private_data->latency.event_time;
+  session->private_data->latency.event_time = GDK_CURRENT_TIME;
+
+  t = (t == 0) ? 1 : t;
+  for (unsigned int c = 0; c < t; c++) {
+    for (size_t i = 0; i < sequence->length; i++) {
+      feed_key(session, &sequence->keys[i]);
+    }
+  }
+
+  session->private_data->latency.event_time = event_time;
+  session->private_data->feedkeys.depth--;
+
+  girara_key_sequence_unref(sequence);
+
+  return true;
+}
+
+/* maximal nesting depth of macros replaying other macros */
+static const unsigned int MACRO_MAX_DEPTH = 100;
 
-      update_state_by_keyval(&state, keyval);
-      simulate_key_press(session, state, keyval);
+static void
+macro_replay(girara_session_t* session, guint reg, unsigned int count)
+{
+  GArray* keys = girara_int_map_get(session->private_data->macro.registers, reg);
+  if (keys == NULL) {
+    return;
+  }
+
+  if (session->private_data->macro.depth >= MACRO_MAX_DEPTH) {
+    girara_warning("Macro recursion is too deep");
+    return;
+  }
+
+  /* replayed keys are dispatched right away, so nothing is drawn until the
+   * replay is done */
+  session->private_data->macro.depth++;
+  /* replayed keys are not caused by an event */
+  const guint32 event_time = session->private_data->latency.event_time;
+  session->private_data->latency.event_time = GDK_CURRENT_TIME;
+
+  for (unsigned int c = 0; c < count; c++) {
+    for (guint i = 0; i < keys->len; i++) {
+      const girara_macro_key_t* key = &g_array_index(keys, girara_macro_key_t, i);
+      if (key->inputbar == true) {
+        simulate_key_press(session, key->mask, key->keyval);
+        continue;
+      }
+
+      if (girara_mode_get(session) != key->mode) {
+        girara_mode_set(session, key->mode);
+      }
+      girara_key_dispatch(session, key->keyval, key->mask);
     }
   }
 
+  session->private_data->latency.event_time = event_time;
+  session->private_data->macro.depth--;
+}
+
+bool
+girara_macro_key_press(girara_session_t* session, guint keyval, guint clean)
+{
+  g_return_val_if_fail(session != NULL, false);
+
+  if (session->private_data->macro.recording != NULL &&
+      session->private_data->macro.depth == 0 &&
+      session->private_data->feedkeys.depth == 0) {
+    const girara_macro_key_t key = {
+      .keyval = keyval,
+      .mask   = clean,
+      .mode   = girara_mode_get(session)
+    };
+
+    session->private_data->macro.recording_length =
+      session->private_data->macro.recording->len;
+    g_array_append_val(session->private_data->macro.recording, key);
+  }
+
+  const girara_macro_pending_t pending = session->private_data->macro.pending;
+  if (pending == GIRARA_MACRO_NONE) {
+    return false;
+  }
+
+  session->private_data->macro.pending = GIRARA_MACRO_NONE;
+
+  /* registers are named by printable characters */
+  if (keyval < 0x21 || keyval > 0x7E) {
+    return true;
+  }
+
+  if (pending == GIRARA_MACRO_RECORD) {
+    GArray* keys = g_array_new(FALSE, FALSE, sizeof(girara_macro_key_t));
+    girara_int_map_set(session->private_data->macro.registers, keyval, keys);
+
+    session->private_data->macro.recording        = keys;
+    session->private_data->macro.recording_length = 0;
+  } else {
+    macro_replay(session, keyval, session->private_data->macro.count);
+  }
+
   return true;
 }
 
+void
+girara_macro_inputbar_key_press(girara_session_t* session, guint keyval,
+    guint state)
+{
+  g_return_if_fail(session != NULL);
+
+  if (session->private_data->macro.recording == NULL ||
+      session->private_data->macro.depth != 0 ||
+      session->private_data->feedkeys.depth != 0) {
+    return;
+  }
+
+  const girara_macro_key_t key = {
+    .keyval   = keyval,
+    .mask     = state,
+    .inputbar = true
+  };
+
+  g_array_append_val(session->private_data->macro.recording, key);
+}
+
+bool
+girara_sc_macro_record(girara_session_t* session, girara_argument_t*
+    UNUSED(argument), girara_event_t* UNUSED(event), unsigned int UNUSED(t))
+{
+  g_return_val_if_fail(session != NULL, false);
+
+  /* macros can not be recorded from within a macro */
+  if (session->private_data->macro.depth != 0) {
+    return false;
+  }
+
+  if (session->private_data->macro.recording != NULL) {
+    /* the key that stopped the recording is not part of the macro */
+    g_array_set_size(session->private_data->macro.recording,
+        session->private_data->macro.recording_length);
+    session->private_data->macro.recording = NULL;
+    return false;
+  }
+
+  session->private_data->macro.pending = GIRARA_MACRO_RECORD;
+  return false;
+}
+
+bool
+girara_sc_macro_replay(girara_session_t* session, girara_argument_t*
+    UNUSED(argument), girara_event_t* UNUSED(event), unsigned int t)
+{
+  g_return_val_if_fail(session != NULL, false);
+
+  session->private_data->macro.pending = GIRARA_MACRO_REPLAY;
+  session->private_data->macro.count   = (t == 0) ? 1 : t;
+  return false;
+}
+
 bool
 girara_shortcut_mapping_add(girara_session_t* session, const char* identifier, girara_shortcut_function_t function)
 {
@@ -616,20 +1163,23 @@ girara_shortcut_mapping_add(girara_session_t* session, const char* identifier, g
     return false;
   }
 
-  GIRARA_LIST_FOREACH(session->config.shortcut_mappings, girara_shortcut_mapping_t*, iter, data)
-    if (strcmp(data->identifier, identifier) == 0) {
-      data->function = function;
-      girara_list_iterator_free(iter);
-      return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->config.shortcut_mappings, girara_shortcut_mapping_t*, iter, data);
+  girara_shortcut_mapping_t* data = girara_map_get(
+      session->private_data->shortcut_mapping_index, identifier);
+  if (data != NULL) {
+    data->function = function;
+    return true;
+  }
 
   /* add new config handle */
-  girara_shortcut_mapping_t* mapping = g_slice_new(girara_shortcut_mapping_t);
+  girara_shortcut_mapping_t* mapping = girara_session_alloc(session,
+      GIRARA_MEMORY_CONFIG, sizeof(girara_shortcut_mapping_t));
 
-  mapping->identifier = g_strdup(identifier);
+  mapping->identifier = girara_session_strdup(session, GIRARA_MEMORY_CONFIG,
+      identifier);
   mapping->function   = function;
   girara_list_append(session->config.shortcut_mappings, mapping);
+  girara_map_set(session->private_data->shortcut_mapping_index,
+      mapping->identifier, mapping);
 
   return true;
 }
@@ -654,20 +1204,23 @@ girara_argument_mapping_add(girara_session_t* session, const char* identifier, i
     return false;
   }
 
-  GIRARA_LIST_FOREACH(session->config.argument_mappings, girara_argument_mapping_t*, iter, mapping);
-    if (g_strcmp0(mapping->identifier, identifier) == 0) {
-      mapping->value = value;
-      girara_list_iterator_free(iter);
-      return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->config.argument_mappings, girara_argument_mapping_t*, iter, mapping);
+  girara_argument_mapping_t* existing = girara_map_get(
+      session->private_data->argument_mapping_index, identifier);
+  if (existing != NULL) {
+    existing->value = value;
+    return true;
+  }
 
   /* add new config handle */
-  girara_argument_mapping_t* mapping = g_slice_new(girara_argument_mapping_t);
+  girara_argument_mapping_t* mapping = girara_session_alloc(session,
+      GIRARA_MEMORY_CONFIG, sizeof(girara_argument_mapping_t));
 
-  mapping->identifier = g_strdup(identifier);
+  mapping->identifier = girara_session_strdup(session, GIRARA_MEMORY_CONFIG,
+      identifier);
   mapping->value      = value;
   girara_list_append(session->config.argument_mappings, mapping);
+  girara_map_set(session->private_data->argument_mapping_index,
+      mapping->identifier, mapping);
 
   return true;
 }
@@ -683,6 +1236,78 @@ girara_argument_mapping_free(girara_argument_mapping_t* argument_mapping)
   g_slice_free(girara_argument_mapping_t, argument_mapping);
 }
 
+static bool
+mouse_event_uses_button(girara_event_type_t event_type)
+{
+  switch (event_type) {
+    case GIRARA_EVENT_BUTTON_PRESS:
+    case GIRARA_EVENT_2BUTTON_PRESS:
+    case GIRARA_EVENT_3BUTTON_PRESS:
+    case GIRARA_EVENT_BUTTON_RELEASE:
+      return true;
+    default:
+      /* motion and scroll events are dispatched regardless of the button */
+      return false;
+  }
+}
+
+static intptr_t
+mouse_event_index_key(girara_event_type_t event_type, girara_mode_t mode,
+    guint mask, guint button)
+{
+  if (mouse_event_uses_button(event_type) == false) {
+    button = 0;
+  }
+
+  guint hash = event_type;
+  hash = hash * 31 + mode;
+  hash = hash * 31 + mask;
+  hash = hash * 31 + button;
+
+  return hash;
+}
+
+static girara_mouse_event_t*
+mouse_event_index_find(girara_session_t* session,
+    girara_event_type_t event_type, girara_mode_t mode, guint mask,
+    guint button, bool exact)
+{
+  girara_list_t* bucket = girara_int_map_get(session->private_data->mouse_event_index,
+      mouse_event_index_key(event_type, mode, mask, button));
+  if (bucket == NULL) {
+    return NULL;
+  }
+
+  const bool match_button = exact == true || mouse_event_uses_button(event_type) == true;
+  GIRARA_LIST_FOREACH_STACK(bucket, girara_mouse_event_t*, iter, mouse_event)
+    if (mouse_event->event_type == event_type && mouse_event->mode == mode
+        && mouse_event->mask == mask
+        && (match_button == false || mouse_event->button == button)) {
+      return mouse_event;
+    }
+  GIRARA_LIST_FOREACH_STACK_END(bucket, girara_mouse_event_t*, iter, mouse_event);
+
+  return NULL;
+}
+
+girara_mouse_event_t*
+girara_mouse_event_find(girara_session_t* session,
+    girara_event_type_t event_type, girara_mode_t mode, guint mask,
+    guint button)
+{
+  g_return_val_if_fail(session != NULL, NULL);
+
+  /* bindings for the given mode take precedence over those for all modes */
+  girara_mouse_event_t* mouse_event = mouse_event_index_find(session,
+      event_type, mode, mask, button, false);
+  if (mouse_event == NULL && mode != 0) {
+    mouse_event = mouse_event_index_find(session, event_type, 0, mask, button,
+        false);
+  }
+
+  return mouse_event;
+}
+
 bool
 girara_mouse_event_add(girara_session_t* session, guint mask, guint button,
     girara_shortcut_function_t function, girara_mode_t mode, girara_event_type_t
@@ -694,19 +1319,17 @@ girara_mouse_event_add(girara_session_t* session, guint mask, guint button,
   girara_argument_t argument = {argument_n, argument_data};
 
   /* search for existing binding */
-  GIRARA_LIST_FOREACH(session->bindings.mouse_events, girara_mouse_event_t*, iter, me_it)
-    if (me_it->mask == mask && me_it->button == button &&
-       me_it->mode == mode && me_it->event_type == event_type)
-    {
-      me_it->function = function;
-      me_it->argument = argument;
-      girara_list_iterator_free(iter);
-      return true;
-    }
-  GIRARA_LIST_FOREACH_END(session->bindings.mouse_events, girara_mouse_event_t*, iter, me_it);
+  girara_mouse_event_t* me_it = mouse_event_index_find(session, event_type,
+      mode, mask, button, true);
+  if (me_it != NULL) {
+    me_it->function = function;
+    me_it->argument = argument;
+    return true;
+  }
 
   /* add new mouse event */
-  girara_mouse_event_t* mouse_event = g_slice_new(girara_mouse_event_t);
+  girara_mouse_event_t* mouse_event = girara_session_alloc(session,
+      GIRARA_MEMORY_SHORTCUTS, sizeof(girara_mouse_event_t));
 
   mouse_event->mask       = mask;
   mouse_event->button     = button;
@@ -716,6 +1339,36 @@ girara_mouse_event_add(girara_session_t* session, guint mask, guint button,
   mouse_event->argument   = argument;
   girara_list_append(session->bindings.mouse_events, mouse_event);
 
+  /* index the new binding */
+  const intptr_t index_key = mouse_event_index_key(event_type, mode, mask, button);
+  girara_list_t* bucket    = girara_int_map_get(session->private_data->mouse_event_index, index_key);
+  if (bucket == NULL) {
+    bucket = girara_list_new();
+    girara_int_map_set(session->private_data->mouse_event_index, index_key, bucket);
+  }
+  girara_list_append(bucket, mouse_event);
+
+  return true;
+}
+
+bool
+girara_mouse_event_set_coalesce(girara_session_t* session, guint mask,
+    guint button, girara_mode_t mode, girara_event_type_t event_type,
+    bool coalesce)
+{
+  g_return_val_if_fail(session != NULL, false);
+
+  if (mouse_event_uses_button(event_type) == true) {
+    return false;
+  }
+
+  girara_mouse_event_t* mouse_event = mouse_event_index_find(session,
+      event_type, mode, mask, button, true);
+  if (mouse_event == NULL) {
+    return false;
+  }
+
+  mouse_event->coalesce = coalesce;
   return true;
 }
 
@@ -729,6 +1382,17 @@ girara_mouse_event_remove(girara_session_t* session, guint mask, guint button, g
     if (me_it->mask == mask && me_it->button == button &&
        me_it->mode == mode)
     {
+      const intptr_t index_key = mouse_event_index_key(me_it->event_type,
+          me_it->mode, me_it->mask, me_it->button);
+      girara_list_t* bucket    = girara_int_map_get(session->private_data->mouse_event_index, index_key);
+      girara_list_remove(bucket, me_it);
+      if (me_it->pending_count != 0) {
+        girara_list_remove(session->private_data->pending_mouse_events, me_it);
+      }
+      if (girara_list_size(bucket) == 0) {
+        girara_int_map_remove(session->private_data->mouse_event_index, index_key);
+      }
+
       girara_list_remove(session->bindings.mouse_events, me_it);
       girara_list_iterator_free(iter);
       return true;
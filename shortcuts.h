@@ -40,6 +40,42 @@ bool girara_shortcut_add(girara_session_t* session, guint modifier, guint key,
 bool girara_shortcut_remove(girara_session_t* session, guint modifier, guint
     key, const char* buffer, girara_mode_t mode);
 
+/**
+ * Starts a transaction for adding many shortcuts at once, e.g. while loading
+ * a keymap. Shortcuts added during the transaction are merged with the
+ * existing ones in a single step when the transaction is committed and are
+ * not dispatched before. Transactions can be nested; only committing the
+ * outermost one merges the shortcuts. Mouse events are not affected by
+ * transactions.
+ *
+ * @param session The used girara session
+ */
+void girara_shortcut_transaction_begin(girara_session_t* session);
+
+/**
+ * Commits a transaction started with girara_shortcut_transaction_begin
+ *
+ * @param session The used girara session
+ */
+void girara_shortcut_transaction_commit(girara_session_t* session);
+
+/**
+ * Marks a shortcut as count aware. The function of a count aware shortcut is
+ * called once with the given count instead of being repeated count times.
+ * Rebinding the shortcut to another function resets the flag.
+ *
+ * @param session The used girara session
+ * @param modifier The modifier
+ * @param key The key
+ * @param buffer Buffer command
+ * @param mode Available modes
+ * @param count_aware true if the function handles the count itself
+ * @return true No error occured
+ * @return false The shortcut does not exist
+ */
+bool girara_shortcut_set_count_aware(girara_session_t* session, guint modifier,
+    guint key, const char* buffer, girara_mode_t mode, bool count_aware);
+
 /**
  * Adds an inputbar shortcut
  *
@@ -211,6 +247,33 @@ bool girara_sc_toggle_tabbar(girara_session_t* session, girara_argument_t*
 bool girara_sc_set(girara_session_t* session, girara_argument_t* argument,
     girara_event_t* event, unsigned int t);
 
+/**
+ * Starts recording the keys pressed in the view into the register selected by
+ * the next key, or stops a running recording
+ *
+ * @param session The used girara session
+ * @param argument The argument
+ * @param event Girara event
+ * @param t Number of executions
+ * @return true No error occured
+ * @return false An error occured (abort execution)
+ */
+bool girara_sc_macro_record(girara_session_t* session, girara_argument_t*
+    argument, girara_event_t* event, unsigned int t);
+
+/**
+ * Replays the register selected by the next key t times
+ *
+ * @param session The used girara session
+ * @param argument The argument
+ * @param event Girara event
+ * @param t Number of executions
+ * @return true No error occured
+ * @return false An error occured (abort execution)
+ */
+bool girara_sc_macro_replay(girara_session_t* session, girara_argument_t*
+    argument, girara_event_t* event, unsigned int t);
+
 /**
  * Default inputbar shortcut to abort
  *
@@ -319,4 +382,25 @@ bool girara_mouse_event_add(girara_session_t* session, guint mask, guint button,
 bool girara_mouse_event_remove(girara_session_t* session, guint mask,
     guint button, girara_mode_t mode);
 
+/**
+ * Enables or disables coalescing of a motion or scroll binding. Events of a
+ * coalesced binding are collected until the next frame of the view and the
+ * bound function is called once per frame. Motion events report the last
+ * position, smooth scroll events report the sum of the deltas and discrete
+ * scroll events pass the number of collected steps as count.
+ *
+ * @param session The used girara session
+ * @param mask The mask
+ * @param button Pressed button
+ * @param mode Available mode
+ * @param event_type Event type
+ * @param coalesce true to dispatch at most once per frame
+ * @return true No error occured
+ * @return false The binding does not exist or is not a motion or scroll
+ *   binding
+ */
+bool girara_mouse_event_set_coalesce(girara_session_t* session, guint mask,
+    guint button, girara_mode_t mode, girara_event_type_t event_type,
+    bool coalesce);
+
 #endif
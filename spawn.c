@@ -0,0 +1,275 @@
+/* See LICENSE file for license and copyright information */
+
+#define _XOPEN_SOURCE 700
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <glib.h>
+#include <glib/gi18n-lib.h>
+#if GLIB_CHECK_VERSION(2, 30, 0)
+#include <glib-unix.h>
+#endif
+
+#include "datastructures.h"
+#include "internal.h"
+#include "session.h"
+#include "utils.h"
+
+extern char** environ;
+
+#define CHILD_STDOUT 0
+#define CHILD_STDERR 1
+
+struct girara_child_s
+{
+  girara_session_t* session; /**< Session or NULL if it has been destroyed */
+  GPid pid; /**< Process id */
+  girara_child_exit_function_t callback; /**< Exit callback */
+  void* data; /**< Data passed to the callback */
+  guint watch; /**< Child watch that reaps the process */
+  guint output[2]; /**< Watches of the stdout and stderr pipes */
+  int status; /**< Exit status once the child has been reaped */
+};
+
+static void
+child_release(girara_child_t* child)
+{
+  /* the child is kept until it has been reaped and its output is drained, so
+   * the exit is reported after the last line of output */
+  if (child->watch != 0 || child->output[CHILD_STDOUT] != 0 ||
+      child->output[CHILD_STDERR] != 0) {
+    return;
+  }
+
+  if (child->session != NULL) {
+    girara_int_map_remove(child->session->private_data->children, child->pid);
+  }
+
+  if (child->callback != NULL) {
+    child->callback(child->session, child->pid, child->status, child->data);
+  }
+
+  g_slice_free(girara_child_t, child);
+}
+
+static gboolean
+child_output(girara_child_t* child, unsigned int stream, GIOChannel* channel,
+    GIOCondition condition)
+{
+  GIOStatus status = G_IO_STATUS_EOF;
+
+  if ((condition & G_IO_IN) != 0) {
+    char* line = NULL;
+    while ((status = g_io_channel_read_line(channel, &line, NULL, NULL, NULL)) == G_IO_STATUS_NORMAL) {
+      g_strchomp(line);
+      if (child->session != NULL && line[0] != '\0' &&
+          g_utf8_validate(line, -1, NULL) == TRUE) {
+        girara_notify(child->session,
+            stream == CHILD_STDOUT ? GIRARA_INFO : GIRARA_WARNING, "%s", line);
+      }
+      g_free(line);
+      line = NULL;
+    }
+  }
+
+  if (status == G_IO_STATUS_AGAIN) {
+    return TRUE;
+  }
+
+  child->output[stream] = 0;
+  child_release(child);
+  return FALSE;
+}
+
+static gboolean
+cb_child_stdout(GIOChannel* channel, GIOCondition condition, void* data)
+{
+  return child_output(data, CHILD_STDOUT, channel, condition);
+}
+
+static gboolean
+cb_child_stderr(GIOChannel* channel, GIOCondition condition, void* data)
+{
+  return child_output(data, CHILD_STDERR, channel, condition);
+}
+
+static void
+cb_child_exit(GPid pid, gint status, void* data)
+{
+  girara_child_t* child = data;
+
+  g_spawn_close_pid(pid);
+
+  child->status = status;
+  child->watch  = 0;
+  child_release(child);
+}
+
+static guint
+child_output_watch(girara_child_t* child, int fd, GIOFunc function)
+{
+  GIOChannel* channel = g_io_channel_unix_new(fd);
+  g_io_channel_set_close_on_unref(channel, TRUE);
+  /* output is passed through as is, invalid lines are skipped */
+  g_io_channel_set_encoding(channel, NULL, NULL);
+  g_io_channel_set_flags(channel, G_IO_FLAG_NONBLOCK, NULL);
+
+  const guint source = g_io_add_watch(channel, G_IO_IN | G_IO_HUP | G_IO_ERR,
+      function, child);
+  g_io_channel_unref(channel);
+
+  return source;
+}
+
+static bool
+pipe_open(int fds[2])
+{
+  /* descriptors are opened close-on-exec at once, so no child spawned in the
+   * meantime inherits them */
+#if GLIB_CHECK_VERSION(2, 30, 0)
+  return g_unix_open_pipe(fds, FD_CLOEXEC, NULL) == TRUE;
+#else
+  if (pipe(fds) != 0) {
+    return false;
+  }
+
+  fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+  fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+  return true;
+#endif
+}
+
+static void
+pipes_close(int pipes[2][2])
+{
+  for (unsigned int i = 0; i < 2; i++) {
+    for (unsigned int j = 0; j < 2; j++) {
+      if (pipes[i][j] != -1) {
+        close(pipes[i][j]);
+        pipes[i][j] = -1;
+      }
+    }
+  }
+}
+
+bool
+girara_spawn(girara_session_t* session, char* const argv[],
+    girara_spawn_flags_t flags, girara_child_exit_function_t callback,
+    void* data, int* child_pid)
+{
+  g_return_val_if_fail(argv != NULL && argv[0] != NULL, false);
+
+  const bool capture = session != NULL && (flags & GIRARA_SPAWN_CAPTURE_OUTPUT) != 0;
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+
+  int pipes[2][2] = { { -1, -1 }, { -1, -1 } };
+  int error = 0;
+  if (capture == true) {
+    for (unsigned int i = 0; i < 2 && error == 0; i++) {
+      if (pipe_open(pipes[i]) == false) {
+        error = errno;
+        break;
+      }
+
+      /* only the duplicated write ends survive the exec */
+      error = posix_spawn_file_actions_adddup2(&actions, pipes[i][1],
+          i == CHILD_STDOUT ? STDOUT_FILENO : STDERR_FILENO);
+    }
+  }
+
+#ifdef __GLIBC_PREREQ
+#if __GLIBC_PREREQ(2, 34)
+  /* like g_spawn, pass on no descriptors besides stdin, stdout and stderr */
+  if (error == 0) {
+    error = posix_spawn_file_actions_addclosefrom_np(&actions, STDERR_FILENO + 1);
+  }
+#endif
+#endif
+
+  pid_t pid = 0;
+  if (error == 0) {
+    error = posix_spawnp(&pid, argv[0], &actions, NULL, argv, environ);
+  }
+  posix_spawn_file_actions_destroy(&actions);
+
+  if (error != 0) {
+    pipes_close(pipes);
+    girara_warning("Failed to execute command: %s", g_strerror(error));
+    if (session != NULL) {
+      girara_notify(session, GIRARA_ERROR, _("Failed to execute command: %s"),
+          g_strerror(error));
+    }
+    return false;
+  }
+
+  girara_debug("spawned %s with pid %d", argv[0], (int) pid);
+
+  girara_child_t* child = g_slice_new0(girara_child_t);
+  child->session  = session;
+  child->pid      = pid;
+  child->callback = callback;
+  child->data     = data;
+
+  if (capture == true) {
+    /* the write ends belong to the child now */
+    close(pipes[CHILD_STDOUT][1]);
+    close(pipes[CHILD_STDERR][1]);
+
+    child->output[CHILD_STDOUT] = child_output_watch(child,
+        pipes[CHILD_STDOUT][0], cb_child_stdout);
+    child->output[CHILD_STDERR] = child_output_watch(child,
+        pipes[CHILD_STDERR][0], cb_child_stderr);
+  }
+
+  if (session != NULL) {
+    girara_int_map_set(session->private_data->children, pid, child);
+  }
+  child->watch = g_child_watch_add(pid, cb_child_exit, child);
+
+  if (child_pid != NULL) {
+    *child_pid = pid;
+  }
+
+  return true;
+}
+
+void
+girara_children_detach(girara_session_t* session)
+{
+  g_return_if_fail(session != NULL);
+
+  if (session->private_data->children == NULL) {
+    return;
+  }
+
+  /* children keep running and are still reaped, but nothing is reported to
+   * the destroyed session anymore */
+  girara_map_iterator_t storage;
+  girara_map_iterator_t* iter = girara_map_iterator_init(&storage,
+      session->private_data->children);
+  while (girara_map_iterator_next(iter) == true) {
+    girara_child_t* child = girara_map_iterator_value(iter);
+    child->session  = NULL;
+    child->callback = NULL;
+
+    for (unsigned int i = 0; i < 2; i++) {
+      if (child->output[i] != 0) {
+        g_source_remove(child->output[i]);
+        child->output[i] = 0;
+      }
+    }
+
+    /* children that have been reaped already were only waiting for output */
+    child_release(child);
+  }
+
+  girara_map_free(session->private_data->children);
+  session->private_data->children = NULL;
+}
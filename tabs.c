@@ -19,7 +19,7 @@ static bool girara_callback_tab_clicked(GtkWidget* widget, GdkEventButton* event
 void
 girara_tabs_enable(girara_session_t* session)
 {
-  if (session == NULL || session->gtk.tabs == NULL) {
+  if (session == NULL || girara_session_get_tabs(session) == NULL) {
     return;
   }
 
@@ -27,7 +27,7 @@ girara_tabs_enable(girara_session_t* session)
   girara_set_view(session, GTK_WIDGET(session->gtk.tabs));
 
   /* Display tab bar */
-  if (session->gtk.tabbar) {
+  if (girara_session_get_tabbar(session) != NULL) {
     gtk_widget_show(session->gtk.tabbar);
   }
 }
@@ -36,7 +36,9 @@ girara_tab_t*
 girara_tab_new(girara_session_t* session, const char* title, GtkWidget* widget,
     bool next_to_current, void* data)
 {
-  if (session == NULL || widget == NULL) {
+  if (session == NULL || widget == NULL
+      || girara_session_get_tabs(session) == NULL
+      || girara_session_get_tabbar(session) == NULL) {
     return NULL;
   }
 
@@ -225,6 +225,55 @@ START_TEST(test_datastructures_sorted_list) {
   girara_list_free(unsorted_list);
 } END_TEST
 
+static int
+compare_tens(const void* data1, const void* data2)
+{
+  const intptr_t a = (intptr_t) data1 / 10;
+  const intptr_t b = (intptr_t) data2 / 10;
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+START_TEST(test_datastructures_sorted_list_lookup) {
+  girara_list_t* list = girara_sorted_list_new(compare_tens);
+  fail_unless((list != NULL), NULL);
+
+  /* elements comparing equal keep their insertion order */
+  static const intptr_t values[] = { 50, 10, 31, 30, 32, 70 };
+  for (size_t i = 0; i != sizeof(values) / sizeof(values[0]); ++i) {
+    girara_list_append(list, (void*) values[i]);
+  }
+
+  fail_unless(girara_list_position(list, (void*) 10) == 0, NULL);
+  fail_unless(girara_list_position(list, (void*) 31) == 1, NULL);
+  fail_unless(girara_list_position(list, (void*) 30) == 2, NULL);
+  fail_unless(girara_list_position(list, (void*) 32) == 3, NULL);
+  fail_unless(girara_list_position(list, (void*) 70) == 5, NULL);
+  fail_unless(girara_list_position(list, (void*) 33) == -1, NULL);
+  fail_unless(girara_list_contains(list, (void*) 30) == true, NULL);
+  fail_unless(girara_list_contains(list, (void*) 33) == false, NULL);
+  fail_unless((intptr_t) girara_list_nth(list, 4) == 50, NULL);
+
+  girara_list_remove(list, (void*) 30);
+  fail_unless(girara_list_size(list) == 5, NULL);
+  fail_unless(girara_list_contains(list, (void*) 30) == false, NULL);
+  fail_unless(girara_list_position(list, (void*) 32) == 2, NULL);
+
+  /* bulk insert */
+  void* more[] = { (void*) 60, (void*) 0, (void*) 33, (void*) 90 };
+  girara_list_append_array(list, more, sizeof(more) / sizeof(more[0]));
+  fail_unless(girara_list_size(list) == 9, NULL);
+
+  static const intptr_t sorted[] = { 0, 10, 31, 32, 33, 50, 60, 70, 90 };
+  size_t i = 0;
+  GIRARA_LIST_FOREACH_STACK(list, intptr_t, iter, value)
+    fail_unless(value == sorted[i], NULL);
+    fail_unless(girara_list_position(list, (void*) value) == (ssize_t) i, NULL);
+    ++i;
+  GIRARA_LIST_FOREACH_STACK_END(list, intptr_t, iter, value);
+
+  girara_list_free(list);
+} END_TEST
+
 START_TEST(test_datastructures_list_iterator_remove) {
   girara_list_t* list = girara_list_new();
   for (intptr_t i = 0; i != 10; ++i) {
@@ -249,6 +298,39 @@ START_TEST(test_datastructures_list_iterator_remove) {
   }
 } END_TEST
 
+START_TEST(test_datastructures_list_iterator_stack) {
+  girara_list_t* list = girara_list_new();
+  for (intptr_t i = 0; i != 10; ++i) {
+    girara_list_append(list, (void*)i);
+  }
+
+  intptr_t next = 0;
+  GIRARA_LIST_FOREACH_STACK(list, intptr_t, iter, data)
+    fail_unless(next++ == data, NULL);
+    if (data == 5) {
+      girara_list_iterator_remove(iter);
+      continue;
+    }
+  GIRARA_LIST_FOREACH_STACK_END(list, intptr_t, iter, data);
+  fail_unless(next == 10, NULL);
+  fail_unless(girara_list_size(list) == 9, NULL);
+
+  next = 0;
+  GIRARA_LIST_FOREACH_STACK(list, intptr_t, iter, data)
+    if (data == 3) {
+      break;
+    }
+    ++next;
+  GIRARA_LIST_FOREACH_STACK_END(list, intptr_t, iter, data);
+  fail_unless(next == 3, NULL);
+
+  girara_list_iterator_t storage;
+  fail_unless(girara_list_iterator_init(&storage, NULL) == &storage, NULL);
+  fail_unless(girara_list_iterator_is_valid(&storage) == false, NULL);
+
+  girara_list_free(list);
+} END_TEST
+
 static void
 node_free(void* data)
 {
@@ -345,6 +427,31 @@ START_TEST(test_datastructures_node) {
   girara_node_free(root);
 } END_TEST
 
+static void
+node_free_count(void* data)
+{
+  if (data == NULL) {
+    ++node_free_called;
+  }
+}
+
+START_TEST(test_datastructures_node_deep) {
+  /* a degenerate tree that would overflow the stack if freed recursively */
+  girara_tree_node_t* root = girara_node_new(NULL);
+  girara_node_set_free_function(root, node_free_count);
+  girara_tree_node_t* node = root;
+  for (unsigned int i = 0; i != 500000; ++i) {
+    node = girara_node_append_data(node, NULL);
+    if (i % 1000 == 0) {
+      girara_node_append_data(girara_node_get_parent(node), NULL);
+    }
+  }
+
+  node_free_called = 0;
+  girara_node_free(root);
+  ck_assert_uint_eq(node_free_called, 1 + 500000 + 500);
+} END_TEST
+
 static int
 find_compare(const void* item, const void* data)
 {
@@ -355,6 +462,181 @@ find_compare(const void* item, const void* data)
   }
 }
 
+START_TEST(test_datastructures_node_traversal) {
+  /*        a
+   *      / | \
+   *     b  c  d
+   *    / \     \
+   *   e   f     g
+   *              \
+   *               h
+   */
+  girara_tree_node_t* a = girara_node_new("a");
+  girara_tree_node_t* b = girara_node_append_data(a, "b");
+  girara_node_append_data(a, "c");
+  girara_tree_node_t* d = girara_node_append_data(a, "d");
+  girara_node_append_data(b, "e");
+  girara_node_append_data(b, "f");
+  girara_tree_node_t* g = girara_node_append_data(d, "g");
+  girara_node_append_data(g, "h");
+
+  GString* order = g_string_new(NULL);
+  GIRARA_NODE_FOREACH_CHILD(a, child)
+    g_string_append(order, girara_node_get_data(child));
+  GIRARA_NODE_FOREACH_CHILD_END(a, child);
+  ck_assert_str_eq(order->str, "bcd");
+
+  g_string_truncate(order, 0);
+  for (girara_tree_node_t* node = a; node != NULL; node = girara_node_dfs_next(a, node)) {
+    g_string_append(order, girara_node_get_data(node));
+  }
+  ck_assert_str_eq(order->str, "abefcdgh");
+
+  g_string_truncate(order, 0);
+  for (girara_tree_node_t* node = a; node != NULL; node = girara_node_bfs_next(a, node)) {
+    g_string_append(order, girara_node_get_data(node));
+  }
+  ck_assert_str_eq(order->str, "abcdefgh");
+
+  /* traversal of a subtree */
+  g_string_truncate(order, 0);
+  for (girara_tree_node_t* node = b; node != NULL; node = girara_node_dfs_next(b, node)) {
+    g_string_append(order, girara_node_get_data(node));
+  }
+  ck_assert_str_eq(order->str, "bef");
+
+  /* freeing a node removes it from its parent */
+  girara_node_free(b);
+  fail_unless(girara_node_get_num_children(a) == 2, NULL);
+  fail_unless(girara_node_get_child(a, 1) == d, NULL);
+  fail_unless(girara_node_get_next_sibling(d) == NULL, NULL);
+
+  g_string_free(order, TRUE);
+  girara_node_free(a);
+} END_TEST
+
+static unsigned int node_loader_called = 0;
+
+static void
+node_loader(girara_tree_node_t* node, void* data)
+{
+  fail_unless(data == (void*) 0xCAFE, NULL);
+  ++node_loader_called;
+
+  /* three levels of two children each */
+  size_t depth = 0;
+  for (girara_tree_node_t* parent = girara_node_get_parent(node); parent != NULL;
+      parent = girara_node_get_parent(parent)) {
+    ++depth;
+  }
+
+  if (depth < 3) {
+    girara_node_append_data(node, NULL);
+    girara_node_append_data(node, NULL);
+  }
+}
+
+START_TEST(test_datastructures_node_lazy) {
+  node_loader_called = 0;
+  girara_tree_node_t* root = girara_node_new(NULL);
+  girara_node_set_loader(root, node_loader, (void*) 0xCAFE);
+  fail_unless(girara_node_is_loaded(root) == false, NULL);
+  fail_unless(node_loader_called == 0, NULL);
+
+  fail_unless(girara_node_get_num_children(root) == 2, NULL);
+  fail_unless(girara_node_is_loaded(root) == true, NULL);
+  fail_unless(node_loader_called == 1, NULL);
+
+  girara_tree_node_t* child = girara_node_get_child(root, 0);
+  fail_unless(girara_node_is_loaded(child) == false, NULL);
+  fail_unless(node_loader_called == 1, NULL);
+
+  girara_list_t* children = girara_node_get_children(child);
+  fail_unless(girara_list_size(children) == 2, NULL);
+  fail_unless(node_loader_called == 2, NULL);
+  girara_list_free(children);
+
+  size_t count = 0;
+  for (girara_tree_node_t* node = root; node != NULL; node = girara_node_dfs_next(root, node)) {
+    ++count;
+  }
+  fail_unless(count == 15, NULL);
+  fail_unless(node_loader_called == 15, NULL);
+
+  girara_node_free(root);
+} END_TEST
+
+static unsigned int map_free_called = 0;
+
+static void
+map_free(void* data)
+{
+  fail_unless(data != NULL, NULL);
+  ++map_free_called;
+  g_free(data);
+}
+
+START_TEST(test_datastructures_map) {
+  map_free_called = 0;
+  girara_map_t* map = girara_map_new2(map_free);
+  fail_unless((map != NULL), NULL);
+  fail_unless((girara_map_size(map) == 0), NULL);
+  fail_unless((girara_map_get(map, "key") == NULL), NULL);
+
+  fail_unless(girara_map_set(map, "one", g_strdup("1")), NULL);
+  fail_unless(girara_map_set(map, "two", g_strdup("2")), NULL);
+  fail_unless((girara_map_size(map) == 2), NULL);
+  fail_unless((g_strcmp0(girara_map_get(map, "one"), "1") == 0), NULL);
+  fail_unless(girara_map_contains(map, "two"), NULL);
+  fail_unless(!girara_map_contains(map, "three"), NULL);
+
+  /* replacing frees the old value */
+  fail_unless(girara_map_set(map, "one", g_strdup("one")), NULL);
+  fail_unless((map_free_called == 1), NULL);
+  fail_unless((g_strcmp0(girara_map_get(map, "one"), "one") == 0), NULL);
+  fail_unless((girara_map_size(map) == 2), NULL);
+
+  fail_unless(girara_map_remove(map, "two"), NULL);
+  fail_unless(!girara_map_remove(map, "two"), NULL);
+  fail_unless((map_free_called == 2), NULL);
+  fail_unless((girara_map_size(map) == 1), NULL);
+
+  /* integer functions do not work on string maps */
+  fail_unless((girara_int_map_get(map, 1) == NULL), NULL);
+
+  girara_map_free(map);
+  fail_unless((map_free_called == 3), NULL);
+} END_TEST
+
+START_TEST(test_datastructures_int_map) {
+  girara_map_t* map = girara_int_map_new();
+  fail_unless((map != NULL), NULL);
+
+  for (intptr_t i = 0; i != 100; ++i) {
+    fail_unless(girara_int_map_set(map, i * 7, (void*) (i + 1)), NULL);
+  }
+  fail_unless((girara_map_size(map) == 100), NULL);
+  fail_unless(((intptr_t) girara_int_map_get(map, 14) == 3), NULL);
+  fail_unless(girara_int_map_contains(map, 0), NULL);
+  fail_unless(!girara_int_map_contains(map, 1), NULL);
+  fail_unless(girara_int_map_remove(map, 0), NULL);
+  fail_unless((girara_map_size(map) == 99), NULL);
+
+  intptr_t sum = 0;
+  size_t count = 0;
+  GIRARA_MAP_FOREACH(map, intptr_t, iter, value)
+    fail_unless((girara_map_iterator_int_key(iter) == (value - 1) * 7), NULL);
+    sum += value;
+    ++count;
+  GIRARA_MAP_FOREACH_END(map, intptr_t, iter, value);
+  fail_unless((count == 99), NULL);
+  fail_unless((sum == 5050 - 1), NULL);
+
+  girara_map_clear(map);
+  fail_unless((girara_map_size(map) == 0), NULL);
+  girara_map_free(map);
+} END_TEST
+
 START_TEST(test_datastructures_list_find) {
   girara_list_t* list = girara_list_new();
   fail_unless((list != NULL), NULL);
@@ -405,6 +687,7 @@ Suite* suite_datastructures()
   tcase = tcase_create("list_sorted");
   tcase_add_test(tcase, test_datastructures_sorted_list_basic);
   tcase_add_test(tcase, test_datastructures_sorted_list);
+  tcase_add_test(tcase, test_datastructures_sorted_list_lookup);
   suite_add_tcase(suite, tcase);
 
   /* merge lists */
@@ -422,9 +705,16 @@ Suite* suite_datastructures()
   tcase_add_test(tcase, test_datastructures_list_prepend);
   suite_add_tcase(suite, tcase);
 
+  /* maps */
+  tcase = tcase_create("map");
+  tcase_add_test(tcase, test_datastructures_map);
+  tcase_add_test(tcase, test_datastructures_int_map);
+  suite_add_tcase(suite, tcase);
+
   /* list iterators */
   tcase = tcase_create("list_iterators");
   /* tcase_add_test(tcase, test_datastructures_list_iterator_remove); */
+  tcase_add_test(tcase, test_datastructures_list_iterator_stack);
   suite_add_tcase(suite, tcase);
 
   /* node free */
@@ -435,6 +725,9 @@ Suite* suite_datastructures()
   /* node basics */
   tcase = tcase_create("node_basics");
   tcase_add_test(tcase, test_datastructures_node);
+  tcase_add_test(tcase, test_datastructures_node_traversal);
+  tcase_add_test(tcase, test_datastructures_node_deep);
+  tcase_add_test(tcase, test_datastructures_node_lazy);
   suite_add_tcase(suite, tcase);
 
   return suite;
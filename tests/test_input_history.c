@@ -0,0 +1,118 @@
+/* See LICENSE file for license and copyright information */
+
+#include <check.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <unistd.h>
+
+#include "../input-history.h"
+#include "../datastructures.h"
+
+static char* history_path = NULL;
+
+static void
+setup_file(void)
+{
+  const gint fd = g_file_open_tmp("girara.test.XXXXXX", &history_path, NULL);
+  fail_unless(fd != -1, "Failed to create temporary file.", NULL);
+  close(fd);
+}
+
+static void
+teardown_file(void)
+{
+  g_remove(history_path);
+  g_free(history_path);
+  history_path = NULL;
+}
+
+START_TEST(test_file_read_write) {
+  GiraraInputHistoryIO* io = girara_input_history_file_new(history_path);
+  ck_assert_ptr_ne(io, NULL);
+
+  girara_input_history_io_append(io, "first");
+  girara_input_history_io_append(io, "second");
+
+  girara_list_t* list = girara_input_history_io_read(io);
+  ck_assert_ptr_ne(list, NULL);
+  ck_assert_uint_eq(girara_list_size(list), 2);
+  ck_assert_str_eq((char*) girara_list_nth(list, 0), "first");
+  ck_assert_str_eq((char*) girara_list_nth(list, 1), "second");
+  girara_list_free(list);
+
+  g_object_unref(io);
+} END_TEST
+
+START_TEST(test_file_tail) {
+  GiraraInputHistoryIO* writer = girara_input_history_file_new(history_path);
+  GiraraInputHistoryIO* reader = girara_input_history_file_new(history_path);
+
+  girara_input_history_io_append(writer, "first");
+
+  bool reload = false;
+  girara_list_t* list = girara_input_history_io_tail(reader, &reload);
+  ck_assert_ptr_ne(list, NULL);
+  fail_unless(reload == true, "Initial read should be a full reload.", NULL);
+  ck_assert_uint_eq(girara_list_size(list), 1);
+  girara_list_free(list);
+
+  girara_input_history_io_append(writer, "second");
+  girara_input_history_io_append(writer, "third");
+
+  list = girara_input_history_io_tail(reader, &reload);
+  ck_assert_ptr_ne(list, NULL);
+  fail_unless(reload == false, "Tail should only return new entries.", NULL);
+  ck_assert_uint_eq(girara_list_size(list), 2);
+  ck_assert_str_eq((char*) girara_list_nth(list, 0), "second");
+  ck_assert_str_eq((char*) girara_list_nth(list, 1), "third");
+  girara_list_free(list);
+
+  list = girara_input_history_io_tail(reader, &reload);
+  ck_assert_ptr_ne(list, NULL);
+  ck_assert_uint_eq(girara_list_size(list), 0);
+  girara_list_free(list);
+
+  g_object_unref(reader);
+  g_object_unref(writer);
+} END_TEST
+
+START_TEST(test_shared_history) {
+  GiraraInputHistoryIO* io1 = girara_input_history_file_new(history_path);
+  GiraraInputHistoryIO* io2 = girara_input_history_file_new(history_path);
+  GiraraInputHistory* history1 = girara_input_history_new(io1);
+  GiraraInputHistory* history2 = girara_input_history_new(io2);
+  g_object_unref(io1);
+  g_object_unref(io2);
+
+  girara_input_history_append(history1, "one");
+  girara_input_history_append(history2, "two");
+  girara_input_history_append(history1, "one");
+
+  girara_input_history_reset(history2);
+  girara_list_t* list = girara_input_history_list(history2);
+  ck_assert_uint_eq(girara_list_size(list), 2);
+  ck_assert_str_eq((char*) girara_list_nth(list, 0), "two");
+  ck_assert_str_eq((char*) girara_list_nth(list, 1), "one");
+
+  g_object_unref(history2);
+  g_object_unref(history1);
+} END_TEST
+
+extern void setup(void);
+
+Suite* suite_input_history()
+{
+  TCase* tcase = NULL;
+  Suite* suite = suite_create("InputHistory");
+
+  /* file based storage */
+  tcase = tcase_create("file");
+  tcase_add_checked_fixture(tcase, setup, NULL);
+  tcase_add_checked_fixture(tcase, setup_file, teardown_file);
+  tcase_add_test(tcase, test_file_read_write);
+  tcase_add_test(tcase, test_file_tail);
+  tcase_add_test(tcase, test_shared_history);
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
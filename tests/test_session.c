@@ -1,8 +1,67 @@
 /* See LICENSE file for license and copyright information */
 
 #include <check.h>
+#include <string.h>
 
+#include "../callbacks.h"
+#include "../commands.h"
+#include "../datastructures.h"
+#include "../internal.h"
 #include "../session.h"
+#include "../settings.h"
+#include "../shortcuts.h"
+
+static unsigned int sc_counted_calls = 0;
+static unsigned int sc_counted_t     = 0;
+
+static bool
+sc_counted(girara_session_t* GIRARA_UNUSED(session), girara_argument_t* GIRARA_UNUSED(argument),
+    girara_event_t* GIRARA_UNUSED(event), unsigned int t)
+{
+  ++sc_counted_calls;
+  sc_counted_t = t;
+  return true;
+}
+
+static unsigned int sp_counted_calls = 0;
+static char sp_counted_input[32];
+
+static bool
+sp_counted(girara_session_t* GIRARA_UNUSED(session), const char* input,
+    girara_argument_t* GIRARA_UNUSED(argument))
+{
+  ++sp_counted_calls;
+  g_strlcpy(sp_counted_input, input, sizeof(sp_counted_input));
+  return true;
+}
+
+static unsigned int spc_calls = 0;
+static char spc_input[32];
+static GCancellable* spc_cancellables[4];
+
+static bool
+spc_counted(girara_session_t* GIRARA_UNUSED(session), const char* input,
+    girara_argument_t* GIRARA_UNUSED(argument), GCancellable* cancellable)
+{
+  if (spc_calls < G_N_ELEMENTS(spc_cancellables)) {
+    spc_cancellables[spc_calls] = g_object_ref(cancellable);
+  }
+  ++spc_calls;
+  g_strlcpy(spc_input, input, sizeof(spc_input));
+  return true;
+}
+
+/* runs the main loop until the counter reaches the given number of calls */
+static void
+wait_for_calls(const unsigned int* counter, unsigned int calls)
+{
+  const gint64 end = g_get_monotonic_time() + 5 * G_USEC_PER_SEC;
+  while (*counter < calls && g_get_monotonic_time() < end) {
+    if (g_main_context_iteration(NULL, FALSE) == FALSE) {
+      g_usleep(1000);
+    }
+  }
+}
 
 START_TEST(test_create) {
   girara_session_t* session = girara_session_create();
@@ -18,6 +77,966 @@ START_TEST(test_init) {
   girara_session_destroy(session);
 } END_TEST
 
+START_TEST(test_lazy_widgets) {
+  girara_session_t* session = girara_session_create();
+  fail_unless(session != NULL, "Could not create session");
+  fail_unless(session->gtk.tabs == NULL && session->gtk.tabbar == NULL,
+      "Tabs were created eagerly");
+  fail_unless(session->gtk.notification_area == NULL &&
+      session->gtk.inputbar_dialog == NULL, "Widgets were created eagerly");
+
+  /* widgets created before the session is initialized are packed by init */
+  GtkWidget* tabbar = girara_session_get_tabbar(session);
+  fail_unless(tabbar != NULL && gtk_widget_get_parent(tabbar) == NULL,
+      "Tab bar was packed before init");
+  fail_unless(girara_session_init(session, NULL) == true, "Could not init session");
+  fail_unless(gtk_widget_get_parent(tabbar) == GTK_WIDGET(session->gtk.box),
+      "Tab bar was not packed by init");
+
+  girara_notify(session, GIRARA_INFO, "test");
+  fail_unless(session->gtk.notification_area != NULL, "Notification area was not created");
+  fail_unless(girara_session_get_notification_text(session) == session->gtk.notification_text);
+
+  GtkNotebook* tabs = girara_session_get_tabs(session);
+  fail_unless(tabs != NULL && tabs == session->gtk.tabs, "Tabs were not created");
+
+  /* later ones are packed right away */
+  GtkLabel* dialog = girara_session_get_inputbar_dialog(session);
+  fail_unless(dialog != NULL && gtk_widget_get_parent(GTK_WIDGET(dialog)) ==
+      GTK_WIDGET(session->gtk.inputbar_box), "Dialog was not packed");
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_headless) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+  fail_unless(girara_session_is_headless(session) == true, "Session is not headless");
+  fail_unless(session->gtk.view == NULL, "Headless session created widgets");
+  fail_unless(girara_session_init(session, NULL) == true, "Could not init session");
+
+  fail_unless(girara_command_run(session, ":set n-completion-items 3") == true,
+      "Could not run :set");
+  int items = 0;
+  fail_unless(girara_setting_get(session, "n-completion-items", &items) == true);
+  fail_unless(items == 3, "Setting was not changed");
+
+  fail_unless(girara_command_run(session, ":set guioptions c") == true,
+      "Could not run :set");
+  fail_unless(session->global.hide_statusbar == true, "guioptions was not applied");
+
+  fail_unless(girara_command_run(session, ":no-such-command") == false);
+  fail_unless(girara_command_run(session, ":") == false);
+
+  /* live special commands never saw lines that are run */
+  sp_counted_calls = 0;
+  fail_unless(girara_special_command_add(session, '/', sp_counted, true, 0,
+        NULL) == true, "Could not add special command");
+  fail_unless(girara_command_run(session, "/foo") == true, "Could not run /foo");
+  ck_assert_uint_eq(sp_counted_calls, 1);
+  ck_assert_str_eq(sp_counted_input, "foo");
+  fail_unless(girara_command_run(session, "/foo") == true, "Could not run /foo");
+  ck_assert_uint_eq(sp_counted_calls, 2);
+
+  /* there is no main loop to quit */
+  fail_unless(girara_command_run(session, ":quit") == true, "Could not run :quit");
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_arena) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_ARENA);
+  fail_unless(session != NULL, "Could not create session");
+
+  girara_memory_stats_t before;
+  fail_unless(girara_session_get_memory_stats(session, GIRARA_MEMORY_SETTINGS,
+        &before) == true, "Session does not use an arena");
+  fail_unless(before.objects > 0, "Default settings were not allocated from the arena");
+
+  fail_unless(girara_setting_add(session, "test", "value", STRING, false,
+        "Description", NULL, NULL) == true, "Could not add setting");
+  char* value = "other";
+  fail_unless(girara_setting_set(session, "test", value) == true, "Could not set setting");
+
+  girara_memory_stats_t after;
+  girara_session_get_memory_stats(session, GIRARA_MEMORY_SETTINGS, &after);
+  ck_assert_uint_eq(after.objects, before.objects + 1);
+  fail_unless(after.bytes > before.bytes, "Strings were not accounted for");
+  fail_unless(girara_session_get_arena_size(session) >= after.bytes,
+      "Arena is smaller than its contents");
+
+  fail_unless(girara_shortcut_add(session, 0, 0, "gg", girara_sc_quit, 0, 0,
+        "argument") == true, "Could not add shortcut");
+  fail_unless(girara_shortcut_add(session, 0, 0, "gg", girara_sc_quit, 0, 0,
+        "replaced") == true, "Could not replace shortcut");
+  fail_unless(girara_shortcut_remove(session, 0, 0, "gg", 0) == true,
+      "Could not remove shortcut");
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_arena_disabled) {
+  girara_session_t* session = girara_session_create();
+  fail_unless(session != NULL, "Could not create session");
+
+  girara_memory_stats_t stats;
+  fail_unless(girara_session_get_memory_stats(session, GIRARA_MEMORY_SETTINGS,
+        &stats) == false, "Session should not use an arena");
+  ck_assert_uint_eq(girara_session_get_arena_size(session), 0);
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_latency_empty) {
+  girara_session_t* session = girara_session_create();
+  fail_unless(session != NULL, "Could not create session");
+
+  girara_latency_stats_t stats;
+  fail_unless(girara_session_get_latency_stats(session, GIRARA_LATENCY_KEY_PRESS,
+        &stats) == true, "Could not get latency stats");
+  ck_assert_uint_eq(stats.count, 0);
+  ck_assert_uint_eq(stats.delay_max, 0);
+  ck_assert_uint_eq(stats.duration_max, 0);
+
+  fail_unless(girara_session_get_binding_latency_stats(session, "gg",
+        &stats) == false, "Binding should not have been measured");
+
+  girara_list_t* bindings = girara_session_get_latency_bindings(session);
+  fail_unless(bindings != NULL, "Could not get measured bindings");
+  ck_assert_uint_eq(girara_list_size(bindings), 0);
+  girara_list_free(bindings);
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_latency_histogram) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+
+  /* 98 events are delayed by 1 ms, two by 50 ms */
+  girara_latency_t* latency = girara_latency_get(session, "test");
+  for (unsigned int i = 0; i < 100; i++) {
+    const gint64 start  = g_get_monotonic_time();
+    const guint32 delay = i < 98 ? 1 : 50;
+    girara_latency_record(session, GIRARA_LATENCY_KEY_PRESS, latency,
+        (guint32) (start / 1000) - delay, start);
+  }
+
+  girara_latency_stats_t stats;
+  fail_unless(girara_session_get_binding_latency_stats(session, "test",
+        &stats) == true, "Binding has not been measured");
+  ck_assert_uint_eq(stats.count, 100);
+  /* 1000 µs fall into the bucket [512, 1024) */
+  ck_assert_uint_eq(stats.delay_p50, 1023);
+  /* 50000 µs fall into [32768, 65536), whose bound is capped by the maximum */
+  ck_assert_uint_eq(stats.delay_p99, 50000);
+  ck_assert_uint_eq(stats.delay_max, 50000);
+  fail_unless(stats.duration_p50 <= stats.duration_p99 &&
+      stats.duration_p99 <= stats.duration_max, "Percentiles are not ordered");
+
+  fail_unless(girara_session_get_latency_stats(session, GIRARA_LATENCY_KEY_PRESS,
+        &stats) == true, "Could not get latency stats");
+  ck_assert_uint_eq(stats.count, 100);
+  ck_assert_uint_eq(stats.delay_max, 50000);
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_latency_special) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_slash, NULL, sc_counted,
+        session->modes.normal, 0, NULL), "Could not add shortcut");
+  fail_unless(girara_special_command_add(session, '/', sp_counted, false, 0,
+        NULL) == true, "Could not add special command");
+
+  girara_key_dispatch(session, GDK_KEY_slash, 0);
+  fail_unless(girara_command_run(session, "/foo") == true, "Could not run /foo");
+  fail_unless(girara_command_run(session, "/bar") == true, "Could not run /bar");
+
+  /* the shortcut and the special command are measured separately */
+  girara_latency_stats_t stats;
+  fail_unless(girara_session_get_binding_latency_stats(session, "/",
+        &stats) == true, "Shortcut has not been measured");
+  ck_assert_uint_eq(stats.count, 1);
+  fail_unless(girara_session_get_binding_latency_stats(session, "<special:/>",
+        &stats) == true, "Special command has not been measured");
+  ck_assert_uint_eq(stats.count, 2);
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_latency_feedkeys) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+
+  const girara_mode_t mode = session->modes.normal;
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_j, NULL, sc_counted,
+        mode, 0, NULL), "Could not add shortcut");
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_x, NULL, girara_sc_feedkeys,
+        mode, 0, "jj"), "Could not add shortcut");
+
+  /* x arrives one second after it has been pressed */
+  session->private_data->latency.event_time =
+    (guint32) (g_get_monotonic_time() / 1000) - 1000;
+  girara_key_dispatch(session, GDK_KEY_x, 0);
+
+  girara_latency_stats_t stats;
+  fail_unless(girara_session_get_binding_latency_stats(session, "x",
+        &stats) == true, "Binding has not been measured");
+  ck_assert_uint_eq(stats.count, 1);
+  fail_unless(stats.delay_max >= 1000000, "Delay of x has not been measured");
+
+  /* the fed keys do not inherit the delay of x */
+  fail_unless(girara_session_get_binding_latency_stats(session, "j",
+        &stats) == true, "Binding has not been measured");
+  ck_assert_uint_eq(stats.count, 2);
+  ck_assert_uint_eq(stats.delay_max, 0);
+
+  girara_session_destroy(session);
+} END_TEST
+
+static void
+cb_profile_setting(girara_session_t* GIRARA_UNUSED(session), const char* GIRARA_UNUSED(name),
+    girara_setting_type_t GIRARA_UNUSED(type), void* GIRARA_UNUSED(value),
+    void* GIRARA_UNUSED(data))
+{
+}
+
+START_TEST(test_profile) {
+  girara_session_t* session = girara_session_create();
+  fail_unless(session != NULL, "Could not create session");
+
+  int value = 0;
+  fail_unless(girara_setting_add(session, "profiled", &value, INT, false, NULL,
+        cb_profile_setting, NULL), "Could not add setting");
+  /* both settings share the callback but are profiled separately */
+  fail_unless(girara_setting_add(session, "profiled-too", &value, INT, false, NULL,
+        cb_profile_setting, NULL), "Could not add setting");
+  girara_session_reset_profile(session);
+
+  value = 1;
+  fail_unless(girara_setting_set(session, "profiled", &value), "Could not set setting");
+  fail_unless(girara_setting_set(session, "profiled", &value), "Could not set setting");
+  fail_unless(girara_setting_set(session, "profiled-too", &value), "Could not set setting");
+
+  girara_list_t* profile = girara_session_get_profile(session);
+  fail_unless(profile != NULL, "Could not get profile");
+  ck_assert_uint_eq(girara_list_size(profile), 2);
+
+  unsigned int found = 0;
+  GIRARA_LIST_FOREACH_STACK(profile, girara_profile_entry_t*, iter, entry)
+    ck_assert_int_eq(entry->kind, GIRARA_PROFILE_SETTING);
+    if (g_strcmp0(entry->name, "profiled") == 0) {
+      ck_assert_uint_eq(entry->calls, 2);
+      ++found;
+    } else if (g_strcmp0(entry->name, "profiled-too") == 0) {
+      ck_assert_uint_eq(entry->calls, 1);
+      ++found;
+    }
+  GIRARA_LIST_FOREACH_STACK_END(profile, girara_profile_entry_t*, iter, entry);
+  ck_assert_uint_eq(found, 2);
+  girara_list_free(profile);
+
+  char* report = girara_session_get_profile_report(session);
+  fail_unless(report != NULL && strstr(report, "profiled") != NULL,
+      "Report does not contain the setting");
+  g_free(report);
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_shortcut_transaction) {
+  girara_session_t* session = girara_session_create();
+  fail_unless(session != NULL, "Could not create session");
+
+  const girara_mode_t mode = session->modes.normal;
+
+  girara_shortcut_transaction_begin(session);
+  girara_shortcut_transaction_begin(session);
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_x, NULL, girara_sc_quit,
+        mode, 0, NULL), "Could not add shortcut");
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_x, NULL, girara_sc_set,
+        mode, 0, "first"), "Could not add shortcut");
+  fail_unless(girara_shortcut_add(session, 0, 0, "zz", girara_sc_quit,
+        mode, 0, NULL), "Could not add shortcut");
+  girara_shortcut_transaction_commit(session);
+  girara_shortcut_transaction_commit(session);
+
+  fail_unless(girara_shortcut_set_count_aware(session, 0, GDK_KEY_x, NULL,
+        mode, true), "Shortcut has not been added");
+  fail_unless(girara_shortcut_set_count_aware(session, 0, 0, "zz",
+        mode, true), "Shortcut has not been added");
+
+  /* the duplicate has replaced the first binding */
+  fail_unless(girara_shortcut_remove(session, 0, GDK_KEY_x, NULL, mode),
+      "Could not remove shortcut");
+  fail_unless(girara_shortcut_set_count_aware(session, 0, GDK_KEY_x, NULL,
+        mode, true) == false, "Shortcut has been added twice");
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_count_aware) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+
+  const girara_mode_t mode = session->modes.normal;
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_j, NULL, sc_counted,
+        mode, 0, NULL), "Could not add shortcut");
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_x, NULL, sc_counted,
+        mode, 0, NULL), "Could not add shortcut");
+  fail_unless(girara_shortcut_set_count_aware(session, 0, GDK_KEY_x, NULL,
+        mode, true), "Shortcut has not been added");
+
+  /* other shortcuts are repeated count times */
+  girara_argument_t argument = { 0, "3j" };
+  sc_counted_calls = 0;
+  fail_unless(girara_sc_feedkeys(session, &argument, NULL, 0) == true);
+  ck_assert_uint_eq(sc_counted_calls, 3);
+  ck_assert_uint_eq(sc_counted_t, 3);
+
+  /* count aware shortcuts are called once with the count */
+  argument.data    = "12x";
+  sc_counted_calls = 0;
+  fail_unless(girara_sc_feedkeys(session, &argument, NULL, 0) == true);
+  ck_assert_uint_eq(sc_counted_calls, 1);
+  ck_assert_uint_eq(sc_counted_t, 12);
+
+  /* rebinding to another function clears the flag */
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_x, NULL, girara_sc_feedkeys,
+        mode, 0, "j"), "Could not add shortcut");
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_x, NULL, sc_counted,
+        mode, 0, NULL), "Could not add shortcut");
+  argument.data    = "2x";
+  sc_counted_calls = 0;
+  fail_unless(girara_sc_feedkeys(session, &argument, NULL, 0) == true);
+  ck_assert_uint_eq(sc_counted_calls, 2);
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_feedkeys) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+
+  const girara_mode_t mode = session->modes.normal;
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_j, NULL, sc_counted,
+        mode, 0, NULL), "Could not add shortcut");
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_x, NULL, girara_sc_feedkeys,
+        mode, 0, "jj"), "Could not add shortcut");
+
+  girara_argument_t argument = { 0, "x" };
+  sc_counted_calls = 0;
+  fail_unless(girara_sc_feedkeys(session, &argument, NULL, 0) == true);
+  ck_assert_uint_eq(sc_counted_calls, 2);
+  /* the second time the parsed sequence of the shortcut is used */
+  fail_unless(girara_sc_feedkeys(session, &argument, NULL, 2) == true);
+  ck_assert_uint_eq(sc_counted_calls, 6);
+
+  /* rebinding the shortcut drops its parsed sequence */
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_x, NULL, girara_sc_feedkeys,
+        mode, 0, "j<Down>"), "Could not add shortcut");
+  sc_counted_calls = 0;
+  fail_unless(girara_sc_feedkeys(session, &argument, NULL, 0) == true);
+  ck_assert_uint_eq(sc_counted_calls, 1);
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_macro_feedkeys) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+
+  const girara_mode_t mode = session->modes.normal;
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_j, NULL, sc_counted,
+        mode, 0, NULL), "Could not add shortcut");
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_x, NULL, girara_sc_feedkeys,
+        mode, 0, "jj"), "Could not add shortcut");
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_q, NULL, girara_sc_macro_record,
+        mode, 0, NULL), "Could not add shortcut");
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_at, NULL, girara_sc_macro_replay,
+        mode, 0, NULL), "Could not add shortcut");
+
+  /* record x into register a */
+  sc_counted_calls = 0;
+  girara_key_dispatch(session, GDK_KEY_q, 0);
+  girara_key_dispatch(session, GDK_KEY_a, 0);
+  girara_key_dispatch(session, GDK_KEY_x, 0);
+  girara_key_dispatch(session, GDK_KEY_q, 0);
+  ck_assert_uint_eq(sc_counted_calls, 2);
+
+  /* the keys fed by x are not part of the macro */
+  sc_counted_calls = 0;
+  girara_key_dispatch(session, GDK_KEY_at, 0);
+  girara_key_dispatch(session, GDK_KEY_a, 0);
+  ck_assert_uint_eq(sc_counted_calls, 2);
+
+  girara_session_destroy(session);
+} END_TEST
+
+static girara_shortcut_t*
+shortcut_find(girara_session_t* session, guint key, girara_mode_t mode)
+{
+  GIRARA_LIST_FOREACH_STACK(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut)
+    if (shortcut->key == key && shortcut->mode == mode) {
+      return shortcut;
+    }
+  GIRARA_LIST_FOREACH_STACK_END(session->bindings.shortcuts, girara_shortcut_t*, iter, shortcut);
+
+  return NULL;
+}
+
+START_TEST(test_map) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+
+  fail_unless(girara_shortcut_mapping_add(session, "counted", sc_counted),
+      "Could not add shortcut mapping");
+
+  /* a mode name registered twice resolves to the first registration */
+  const girara_mode_t first  = girara_mode_add(session, "twice");
+  const girara_mode_t second = girara_mode_add(session, "twice");
+  fail_unless(girara_command_run(session, ":map [twice] x counted") == true,
+      "Could not run :map");
+  fail_unless(shortcut_find(session, GDK_KEY_x, first) != NULL,
+      "Shortcut was not mapped in the first mode");
+  fail_unless(second != first, "Modes share an identifier");
+  fail_unless(shortcut_find(session, GDK_KEY_x, second) == NULL,
+      "Shortcut was mapped in the second mode");
+
+  /* a redefined shortcut mapping replaces the function */
+  fail_unless(girara_shortcut_mapping_add(session, "counted", girara_sc_feedkeys),
+      "Could not add shortcut mapping");
+  fail_unless(girara_command_run(session, ":map y counted") == true,
+      "Could not run :map");
+  girara_shortcut_t* shortcut = shortcut_find(session, GDK_KEY_y, session->modes.normal);
+  fail_unless(shortcut != NULL && shortcut->function == girara_sc_feedkeys,
+      "Shortcut does not use the redefined mapping");
+
+  /* special key names are understood by feedkeys */
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_Print, NULL, sc_counted,
+        session->modes.normal, 0, NULL), "Could not add shortcut");
+  fail_unless(girara_command_run(session, ":map z feedkeys <Print>") == true,
+      "Could not run :map");
+  sc_counted_calls = 0;
+  girara_key_dispatch(session, GDK_KEY_z, 0);
+  ck_assert_uint_eq(sc_counted_calls, 1);
+
+  girara_session_destroy(session);
+} END_TEST
+
+static const girara_key_translation_t*
+cached_translation(girara_session_t* session, guint hardware_keycode,
+    GdkModifierType state)
+{
+  for (size_t i = 0; i != GIRARA_KEY_TRANSLATION_CACHE_SIZE; ++i) {
+    const girara_key_translation_t* translation =
+      &session->private_data->key_translations[i];
+    if (translation->valid == true && translation->hardware_keycode == hardware_keycode
+        && translation->state == state) {
+      return translation;
+    }
+  }
+
+  return NULL;
+}
+
+START_TEST(test_key_translation_cache) {
+  girara_session_t* session = girara_session_create();
+  fail_unless(session != NULL, "Could not create session");
+  fail_unless(girara_session_init(session, NULL) == true, "Could not init session");
+
+  fail_unless(girara_shortcut_add(session, 0, GDK_KEY_x, NULL, sc_counted,
+        session->modes.normal, 0, NULL), "Could not add shortcut");
+
+  GdkKeymap* keymap  = gdk_keymap_get_default();
+  GdkKeymapKey* keys = NULL;
+  gint n_keys        = 0;
+  fail_unless(gdk_keymap_get_entries_for_keyval(keymap, GDK_KEY_x, &keys,
+        &n_keys) == TRUE && n_keys > 0, "No key produces x");
+
+  GdkEventKey event = {
+    .type             = GDK_KEY_PRESS,
+    .time             = 1,
+    .hardware_keycode = keys[0].keycode,
+    .group            = keys[0].group
+  };
+  g_free(keys);
+
+  /* the first press is translated, the second one is served from the cache */
+  sc_counted_calls = 0;
+  fail_unless(cached_translation(session, event.hardware_keycode, 0) == NULL,
+      "Key press has been cached already");
+  fail_unless(girara_callback_view_key_press_event(NULL, &event, session) == TRUE,
+      "Key press was not handled");
+  const girara_key_translation_t* translation = cached_translation(session,
+      event.hardware_keycode, 0);
+  fail_unless(translation != NULL, "Key press has not been cached");
+  fail_unless(girara_callback_view_key_press_event(NULL, &event, session) == TRUE,
+      "Key press was not handled");
+  ck_assert_uint_eq(sc_counted_calls, 2);
+
+  /* the cached entry matches a fresh translation */
+  guint keyval              = 0;
+  GdkModifierType consumed  = 0;
+  fail_unless(gdk_keymap_translate_keyboard_state(keymap, event.hardware_keycode,
+        0, event.group, &keyval, NULL, NULL, &consumed) == TRUE,
+      "Could not translate key press");
+  ck_assert_uint_eq(translation->keyval, keyval);
+  ck_assert_uint_eq(translation->clean, 0);
+
+  /* a new keymap invalidates all entries */
+  g_signal_emit_by_name(keymap, "keys-changed");
+  fail_unless(cached_translation(session, event.hardware_keycode, 0) == NULL,
+      "Key translations survived a keymap change");
+  fail_unless(girara_callback_view_key_press_event(NULL, &event, session) == TRUE,
+      "Key press was not handled");
+  ck_assert_uint_eq(sc_counted_calls, 3);
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_inputbar_shortcut_find) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+
+  fail_unless(girara_inputbar_shortcut_find(session, GDK_CONTROL_MASK,
+        GDK_KEY_c)->function == girara_isc_abort, "Default shortcut is missing");
+
+  fail_unless(girara_inputbar_shortcut_add(session, 0, GDK_KEY_x, sc_counted,
+        1, NULL), "Could not add inputbar shortcut");
+  fail_unless(girara_inputbar_shortcut_add(session, GDK_CONTROL_MASK, GDK_KEY_x,
+        sc_counted, 2, NULL), "Could not add inputbar shortcut");
+
+  /* the same key with another mask is another shortcut */
+  girara_inputbar_shortcut_t* plain = girara_inputbar_shortcut_find(session, 0, GDK_KEY_x);
+  fail_unless(plain != NULL && plain->argument.n == 1, "Wrong inputbar shortcut");
+  girara_inputbar_shortcut_t* control = girara_inputbar_shortcut_find(session,
+      GDK_CONTROL_MASK, GDK_KEY_x);
+  fail_unless(control != NULL && control->argument.n == 2, "Wrong inputbar shortcut");
+  fail_unless(girara_inputbar_shortcut_find(session, GDK_SHIFT_MASK, GDK_KEY_x) == NULL,
+      "Found inputbar shortcut with another mask");
+  fail_unless(girara_inputbar_shortcut_find(session, 0, GDK_KEY_j) == NULL,
+      "Found inputbar shortcut for another key");
+
+  /* adding a shortcut again replaces it */
+  const size_t size = girara_list_size(session->bindings.inputbar_shortcuts);
+  fail_unless(girara_inputbar_shortcut_add(session, 0, GDK_KEY_x, sc_counted,
+        3, NULL), "Could not add inputbar shortcut");
+  ck_assert_uint_eq(girara_list_size(session->bindings.inputbar_shortcuts), size);
+  fail_unless(girara_inputbar_shortcut_find(session, 0, GDK_KEY_x) == plain &&
+      plain->argument.n == 3, "Inputbar shortcut was not replaced");
+
+  /* removing one mask keeps the other */
+  fail_unless(girara_inputbar_shortcut_remove(session, GDK_CONTROL_MASK, GDK_KEY_x),
+      "Could not remove inputbar shortcut");
+  fail_unless(girara_inputbar_shortcut_find(session, GDK_CONTROL_MASK, GDK_KEY_x) == NULL,
+      "Found removed inputbar shortcut");
+  fail_unless(girara_inputbar_shortcut_find(session, 0, GDK_KEY_x) == plain,
+      "Lost inputbar shortcut with another mask");
+  fail_unless(girara_inputbar_shortcut_remove(session, 0, GDK_KEY_x),
+      "Could not remove inputbar shortcut");
+  fail_unless(girara_inputbar_shortcut_find(session, 0, GDK_KEY_x) == NULL,
+      "Found removed inputbar shortcut");
+
+  girara_session_destroy(session);
+} END_TEST
+
+static bool
+cmd_noop(girara_session_t* GIRARA_UNUSED(session), girara_list_t* GIRARA_UNUSED(argument_list))
+{
+  return true;
+}
+
+static char*
+command_names(girara_list_t* commands)
+{
+  GString* names = g_string_new(NULL);
+  GIRARA_LIST_FOREACH_STACK(commands, girara_command_t*, iter, command)
+    if (names->len != 0) {
+      g_string_append_c(names, ' ');
+    }
+    g_string_append(names, command->command);
+  GIRARA_LIST_FOREACH_STACK_END(commands, girara_command_t*, iter, command);
+  girara_list_free(commands);
+
+  return g_string_free(names, FALSE);
+}
+
+START_TEST(test_command_find) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+
+  fail_unless(girara_inputbar_command_add(session, "zopen", "zo", cmd_noop, NULL, NULL));
+  fail_unless(girara_inputbar_command_add(session, "zobject", NULL, cmd_noop, NULL, NULL));
+  fail_unless(girara_inputbar_command_add(session, "zwrite", "zw", cmd_noop, NULL, NULL));
+  fail_unless(girara_inputbar_command_add(session, "zedit", "zx", cmd_noop, NULL, NULL));
+  /* the name of one command is the abbreviation of another one */
+  fail_unless(girara_inputbar_command_add(session, "zw", NULL, cmd_noop, NULL, NULL));
+
+  girara_command_t* open = girara_command_find(session, "zopen");
+  fail_unless(open != NULL, "Could not find command by name");
+  fail_unless(girara_command_find(session, "zo") == open, "Could not find command by abbreviation");
+  fail_unless(girara_command_find(session, "zop") == NULL, "Found command by prefix");
+  girara_command_t* write = girara_command_find(session, "zw");
+  fail_unless(write != NULL && g_strcmp0(write->command, "zw") == 0,
+      "Abbreviation took precedence over a name");
+  fail_unless(girara_command_run(session, ":zx") == true, "Could not run command by abbreviation");
+
+  /* commands matching by name and abbreviation are listed once */
+  char* names = command_names(girara_command_find_prefix(session, "zo"));
+  ck_assert_str_eq(names, "zobject zopen");
+  g_free(names);
+
+  names = command_names(girara_command_find_prefix(session, "zop"));
+  ck_assert_str_eq(names, "zopen");
+  g_free(names);
+
+  /* commands matching only by abbreviation are listed as well */
+  names = command_names(girara_command_find_prefix(session, "zx"));
+  ck_assert_str_eq(names, "zedit");
+  g_free(names);
+
+  names = command_names(girara_command_find_prefix(session, "zw"));
+  ck_assert_str_eq(names, "zw zwrite");
+  g_free(names);
+
+  names = command_names(girara_command_find_prefix(session, "zq"));
+  ck_assert_str_eq(names, "");
+  g_free(names);
+
+  /* replacing an abbreviation equal to the name keeps the name */
+  fail_unless(girara_inputbar_command_add(session, "zq", "zq", cmd_noop, NULL, NULL));
+  girara_command_t* quit = girara_command_find(session, "zq");
+  fail_unless(quit != NULL, "Could not find command by name");
+  fail_unless(girara_inputbar_command_add(session, "zq", "zz", cmd_noop, NULL, NULL));
+  fail_unless(girara_command_find(session, "zq") == quit, "Lost command name");
+  fail_unless(girara_command_find(session, "zz") == quit, "Could not find new abbreviation");
+
+  names = command_names(girara_command_find_prefix(session, "zq"));
+  ck_assert_str_eq(names, "zq");
+  g_free(names);
+
+  girara_session_destroy(session);
+} END_TEST
+
+static unsigned int me_counted_calls = 0;
+static unsigned int me_counted_t     = 0;
+static int me_counted_n              = 0;
+static girara_event_t me_counted_event;
+
+static bool
+me_counted(girara_session_t* GIRARA_UNUSED(session), girara_argument_t* argument,
+    girara_event_t* event, unsigned int t)
+{
+  ++me_counted_calls;
+  me_counted_t     = t;
+  me_counted_n     = argument->n;
+  me_counted_event = *event;
+  return true;
+}
+
+START_TEST(test_mouse_event_index) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+
+  const girara_mode_t normal = session->modes.normal;
+  const girara_mode_t other  = girara_mode_add(session, "other");
+
+  fail_unless(girara_mouse_event_add(session, 0, 1, me_counted, 0,
+        GIRARA_EVENT_BUTTON_PRESS, 1, NULL), "Could not add mouse event");
+  fail_unless(girara_mouse_event_add(session, 0, 1, me_counted, normal,
+        GIRARA_EVENT_BUTTON_PRESS, 2, NULL), "Could not add mouse event");
+  fail_unless(girara_mouse_event_add(session, GDK_CONTROL_MASK, 1, me_counted,
+        normal, GIRARA_EVENT_BUTTON_PRESS, 3, NULL), "Could not add mouse event");
+  fail_unless(girara_mouse_event_add(session, 0, 0, me_counted, normal,
+        GIRARA_EVENT_MOTION_NOTIFY, 4, NULL), "Could not add mouse event");
+
+  /* bindings for the current mode take precedence over those for all modes */
+  girara_mouse_event_t* mouse_event = girara_mouse_event_find(session,
+      GIRARA_EVENT_BUTTON_PRESS, normal, 0, 1);
+  fail_unless(mouse_event != NULL && mouse_event->argument.n == 2, "Wrong binding");
+  mouse_event = girara_mouse_event_find(session, GIRARA_EVENT_BUTTON_PRESS, other, 0, 1);
+  fail_unless(mouse_event != NULL && mouse_event->argument.n == 1, "Wrong binding");
+
+  /* masks, buttons and event types are told apart */
+  mouse_event = girara_mouse_event_find(session, GIRARA_EVENT_BUTTON_PRESS,
+      normal, GDK_CONTROL_MASK, 1);
+  fail_unless(mouse_event != NULL && mouse_event->argument.n == 3, "Wrong binding");
+  fail_unless(girara_mouse_event_find(session, GIRARA_EVENT_BUTTON_PRESS,
+        other, GDK_CONTROL_MASK, 1) == NULL, "Found binding of another mode");
+  fail_unless(girara_mouse_event_find(session, GIRARA_EVENT_BUTTON_PRESS,
+        normal, 0, 2) == NULL, "Found binding of another button");
+  fail_unless(girara_mouse_event_find(session, GIRARA_EVENT_BUTTON_RELEASE,
+        normal, 0, 1) == NULL, "Found binding of another event");
+
+  /* motion bindings match any button */
+  mouse_event = girara_mouse_event_find(session, GIRARA_EVENT_MOTION_NOTIFY, normal, 0, 5);
+  fail_unless(mouse_event != NULL && mouse_event->argument.n == 4, "Wrong binding");
+
+  /* adding a binding again replaces it */
+  girara_mouse_event_t* replaced = girara_mouse_event_find(session,
+      GIRARA_EVENT_BUTTON_PRESS, normal, 0, 1);
+  const size_t size = girara_list_size(session->bindings.mouse_events);
+  fail_unless(girara_mouse_event_add(session, 0, 1, me_counted, normal,
+        GIRARA_EVENT_BUTTON_PRESS, 5, NULL), "Could not add mouse event");
+  ck_assert_uint_eq(girara_list_size(session->bindings.mouse_events), size);
+  mouse_event = girara_mouse_event_find(session, GIRARA_EVENT_BUTTON_PRESS, normal, 0, 1);
+  fail_unless(mouse_event == replaced && mouse_event->argument.n == 5,
+      "Binding was not replaced");
+
+  /* removed bindings fall back to those for all modes */
+  fail_unless(girara_mouse_event_remove(session, 0, 1, normal) == true,
+      "Could not remove mouse event");
+  mouse_event = girara_mouse_event_find(session, GIRARA_EVENT_BUTTON_PRESS, normal, 0, 1);
+  fail_unless(mouse_event != NULL && mouse_event->argument.n == 1, "Wrong binding");
+  fail_unless(girara_mouse_event_remove(session, 0, 1, 0) == true,
+      "Could not remove mouse event");
+  fail_unless(girara_mouse_event_find(session, GIRARA_EVENT_BUTTON_PRESS,
+        normal, 0, 1) == NULL, "Found removed binding");
+  fail_unless(girara_mouse_event_remove(session, 0, 1, 0) == false,
+      "Removed binding twice");
+
+  /* events are dispatched to the bound function ... */
+  me_counted_calls = 0;
+  GdkEventButton button = { .type = GDK_BUTTON_PRESS, .state = GDK_CONTROL_MASK, .button = 1 };
+  fail_unless(girara_callback_view_button_press_event(NULL, &button, session) == true,
+      "Button press was not handled");
+  ck_assert_uint_eq(me_counted_calls, 1);
+  ck_assert_int_eq(me_counted_n, 3);
+
+  /* ... unless there is none */
+  mouse_event = girara_mouse_event_find(session, GIRARA_EVENT_BUTTON_PRESS,
+      normal, GDK_CONTROL_MASK, 1);
+  mouse_event->function = NULL;
+  fail_unless(girara_callback_view_button_press_event(NULL, &button, session) == false,
+      "Binding without function handled button press");
+  ck_assert_uint_eq(me_counted_calls, 1);
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_mouse_smooth_scroll) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+
+  const girara_mode_t mode = session->modes.normal;
+  GdkEventScroll scroll = { .type = GDK_SCROLL, .direction = GDK_SCROLL_SMOOTH };
+
+  /* smooth bindings see the deltas */
+  fail_unless(girara_mouse_event_add(session, 0, 0, me_counted, mode,
+        GIRARA_EVENT_SCROLL_BIDIRECTIONAL, 1, NULL), "Could not add mouse event");
+  me_counted_calls = 0;
+  scroll.delta_x   = 0.25;
+  scroll.delta_y   = 1.5;
+  fail_unless(girara_callback_view_scroll_event(NULL, &scroll, session) == true,
+      "Scroll was not handled");
+  ck_assert_uint_eq(me_counted_calls, 1);
+  ck_assert_int_eq(me_counted_event.type, GIRARA_EVENT_SCROLL_BIDIRECTIONAL);
+  fail_unless(me_counted_event.dx == 0.25 && me_counted_event.dy == 1.5,
+      "Deltas did not reach the handler");
+  fail_unless(girara_mouse_event_remove(session, 0, 0, mode) == true,
+      "Could not remove mouse event");
+
+  /* discrete bindings see one event per full step, remainders carry over */
+  fail_unless(girara_mouse_event_add(session, 0, 0, me_counted, mode,
+        GIRARA_EVENT_SCROLL_DOWN, 2, NULL), "Could not add mouse event");
+  fail_unless(girara_mouse_event_add(session, 0, 0, me_counted, mode,
+        GIRARA_EVENT_SCROLL_UP, 3, NULL), "Could not add mouse event");
+
+  /* unbound directions are not handled */
+  me_counted_calls = 0;
+  scroll.delta_x   = 2;
+  scroll.delta_y   = 0;
+  fail_unless(girara_callback_view_scroll_event(NULL, &scroll, session) == false,
+      "Unbound direction was handled");
+  ck_assert_uint_eq(me_counted_calls, 0);
+
+  /* a partial step is swallowed and completed by the next event */
+  scroll.delta_x = 0;
+  scroll.delta_y = 0.6;
+  fail_unless(girara_callback_view_scroll_event(NULL, &scroll, session) == true,
+      "Partial step of a bound direction was not swallowed");
+  ck_assert_uint_eq(me_counted_calls, 0);
+
+  fail_unless(girara_callback_view_scroll_event(NULL, &scroll, session) == true,
+      "Scroll was not handled");
+  ck_assert_uint_eq(me_counted_calls, 1);
+  ck_assert_int_eq(me_counted_n, 2);
+  ck_assert_int_eq(me_counted_event.type, GIRARA_EVENT_SCROLL_DOWN);
+
+  /* 0.2 are left, so 0.9 completes the next step */
+  scroll.delta_y = 0.9;
+  fail_unless(girara_callback_view_scroll_event(NULL, &scroll, session) == true,
+      "Scroll was not handled");
+  ck_assert_uint_eq(me_counted_calls, 2);
+
+  /* 0.1 are left, so -1.3 results in one step up */
+  scroll.delta_y = -1.3;
+  fail_unless(girara_callback_view_scroll_event(NULL, &scroll, session) == true,
+      "Scroll was not handled");
+  ck_assert_uint_eq(me_counted_calls, 3);
+  ck_assert_int_eq(me_counted_n, 3);
+  ck_assert_int_eq(me_counted_event.type, GIRARA_EVENT_SCROLL_UP);
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_mouse_coalesce) {
+  girara_session_t* session = girara_session_create();
+  fail_unless(session != NULL, "Could not create session");
+  fail_unless(girara_session_init(session, NULL) == true, "Could not init session");
+  gtk_widget_show_all(session->gtk.window);
+  gtk_widget_realize(session->gtk.view);
+
+  const girara_mode_t mode = session->modes.normal;
+  fail_unless(girara_mouse_event_add(session, 0, 0, me_counted, mode,
+        GIRARA_EVENT_MOTION_NOTIFY, 0, NULL), "Could not add mouse event");
+  fail_unless(girara_mouse_event_add(session, 0, 0, me_counted, mode,
+        GIRARA_EVENT_SCROLL_DOWN, 0, NULL), "Could not add mouse event");
+  fail_unless(girara_mouse_event_add(session, 0, 0, me_counted, mode,
+        GIRARA_EVENT_SCROLL_BIDIRECTIONAL, 0, NULL), "Could not add mouse event");
+  fail_unless(girara_mouse_event_set_coalesce(session, 0, 0, mode,
+        GIRARA_EVENT_MOTION_NOTIFY, true), "Could not coalesce mouse event");
+  fail_unless(girara_mouse_event_set_coalesce(session, 0, 0, mode,
+        GIRARA_EVENT_SCROLL_DOWN, true), "Could not coalesce mouse event");
+  fail_unless(girara_mouse_event_set_coalesce(session, 0, 0, mode,
+        GIRARA_EVENT_SCROLL_BIDIRECTIONAL, true), "Could not coalesce mouse event");
+  fail_unless(girara_mouse_event_set_coalesce(session, 0, 1, mode,
+        GIRARA_EVENT_BUTTON_PRESS, true) == false, "Coalesced a button binding");
+
+  /* motion reports the last position */
+  me_counted_calls = 0;
+  GdkEventMotion motion = { .type = GDK_MOTION_NOTIFY };
+  for (unsigned int i = 1; i <= 3; i++) {
+    motion.x = 10.0 * i;
+    motion.y = i;
+    fail_unless(girara_callback_view_button_motion_notify_event(session->gtk.view,
+          &motion, session) == true, "Motion was not handled");
+  }
+  ck_assert_uint_eq(me_counted_calls, 0);
+  wait_for_calls(&me_counted_calls, 1);
+  ck_assert_uint_eq(me_counted_calls, 1);
+  ck_assert_int_eq(me_counted_event.type, GIRARA_EVENT_MOTION_NOTIFY);
+  fail_unless(me_counted_event.x == 30.0 && me_counted_event.y == 3.0,
+      "Motion did not report the last position");
+
+  /* discrete scrolling reports the number of steps */
+  me_counted_calls = 0;
+  GdkEventScroll scroll = { .type = GDK_SCROLL, .direction = GDK_SCROLL_DOWN };
+  for (unsigned int i = 0; i < 3; i++) {
+    fail_unless(girara_callback_view_scroll_event(session->gtk.view, &scroll,
+          session) == true, "Scroll was not handled");
+  }
+  ck_assert_uint_eq(me_counted_calls, 0);
+  wait_for_calls(&me_counted_calls, 1);
+  ck_assert_uint_eq(me_counted_calls, 1);
+  ck_assert_int_eq(me_counted_event.type, GIRARA_EVENT_SCROLL_DOWN);
+  ck_assert_uint_eq(me_counted_t, 3);
+
+  /* smooth scrolling reports the sum of the deltas */
+  me_counted_calls = 0;
+  scroll.direction = GDK_SCROLL_SMOOTH;
+  scroll.delta_x   = 0.25;
+  scroll.delta_y   = 1.5;
+  for (unsigned int i = 0; i < 2; i++) {
+    fail_unless(girara_callback_view_scroll_event(session->gtk.view, &scroll,
+          session) == true, "Scroll was not handled");
+  }
+  ck_assert_uint_eq(me_counted_calls, 0);
+  wait_for_calls(&me_counted_calls, 1);
+  ck_assert_uint_eq(me_counted_calls, 1);
+  ck_assert_int_eq(me_counted_event.type, GIRARA_EVENT_SCROLL_BIDIRECTIONAL);
+  fail_unless(me_counted_event.dx == 0.5 && me_counted_event.dy == 3.0,
+      "Smooth scrolling did not sum the deltas");
+
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_special_command_table) {
+  girara_session_t* session = girara_session_create2(GIRARA_SESSION_HEADLESS);
+  fail_unless(session != NULL, "Could not create session");
+
+  fail_unless(girara_command_run(session, "/foo") == false,
+      "Ran unregistered special command");
+
+  fail_unless(girara_special_command_add(session, '/', sp_counted, false, 0,
+        NULL) == true, "Could not add special command");
+  sp_counted_calls = 0;
+  fail_unless(girara_command_run(session, "/foo") == true, "Could not run /foo");
+  ck_assert_uint_eq(sp_counted_calls, 1);
+  ck_assert_str_eq(sp_counted_input, "foo");
+  fail_unless(girara_command_run(session, "?foo") == false,
+      "Ran special command with another identifier");
+
+  /* registering an identifier again replaces the command */
+  const size_t size = girara_list_size(session->bindings.special_commands);
+  fail_unless(girara_special_command_add_cancellable(session, '/', spc_counted,
+        false, 0, 0, NULL) == true, "Could not add special command");
+  ck_assert_uint_eq(girara_list_size(session->bindings.special_commands), size);
+
+  spc_calls = 0;
+  fail_unless(girara_command_run(session, "/bar") == true, "Could not run /bar");
+  ck_assert_uint_eq(sp_counted_calls, 1);
+  ck_assert_uint_eq(spc_calls, 1);
+  ck_assert_str_eq(spc_input, "bar");
+
+  g_object_unref(spc_cancellables[0]);
+  girara_session_destroy(session);
+} END_TEST
+
+START_TEST(test_special_command_debounce) {
+  girara_session_t* session = girara_session_create();
+  fail_unless(session != NULL, "Could not create session");
+  fail_unless(girara_session_init(session, NULL) == true, "Could not init session");
+
+  fail_unless(girara_special_command_add_cancellable(session, '/', spc_counted,
+        true, 50, 0, NULL) == true, "Could not add special command");
+  GtkEntry* entry = session->gtk.inputbar_entry;
+
+  /* only the input left once typing pauses is evaluated */
+  spc_calls = 0;
+  gtk_entry_set_text(entry, "/f");
+  gtk_entry_set_text(entry, "/fo");
+  gtk_entry_set_text(entry, "/foo");
+  ck_assert_uint_eq(spc_calls, 0);
+  wait_for_calls(&spc_calls, 1);
+  ck_assert_uint_eq(spc_calls, 1);
+  ck_assert_str_eq(spc_input, "foo");
+  fail_unless(g_cancellable_is_cancelled(spc_cancellables[0]) == FALSE,
+      "Current execution was cancelled");
+
+  /* newer input supersedes the last execution */
+  gtk_entry_set_text(entry, "/foob");
+  fail_unless(g_cancellable_is_cancelled(spc_cancellables[0]) == TRUE,
+      "Superseded execution was not cancelled");
+  ck_assert_uint_eq(spc_calls, 1);
+
+  /* activating while the input is pending executes it right away */
+  fail_unless(girara_callback_inputbar_activate(entry, session) == true,
+      "Could not activate inputbar");
+  ck_assert_uint_eq(spc_calls, 2);
+  ck_assert_str_eq(spc_input, "foob");
+
+  /* the final execution survives clearing the inputbar and is not repeated */
+  const gint64 end = g_get_monotonic_time() + 100 * 1000;
+  while (g_get_monotonic_time() < end) {
+    if (g_main_context_iteration(NULL, FALSE) == FALSE) {
+      g_usleep(1000);
+    }
+  }
+  ck_assert_uint_eq(spc_calls, 2);
+  fail_unless(g_cancellable_is_cancelled(spc_cancellables[1]) == FALSE,
+      "Final execution was cancelled");
+
+  for (unsigned int i = 0; i != spc_calls; ++i) {
+    g_object_unref(spc_cancellables[i]);
+  }
+  girara_session_destroy(session);
+} END_TEST
+
 extern void setup(void);
 
 Suite* suite_session()
@@ -30,6 +1049,58 @@ Suite* suite_session()
   tcase_add_checked_fixture(tcase, setup, NULL);
   tcase_add_test(tcase, test_create);
   tcase_add_test(tcase, test_init);
+  tcase_add_test(tcase, test_lazy_widgets);
+  tcase_add_test(tcase, test_headless);
+  suite_add_tcase(suite, tcase);
+
+  /* arena */
+  tcase = tcase_create("arena");
+  tcase_add_checked_fixture(tcase, setup, NULL);
+  tcase_add_test(tcase, test_arena);
+  tcase_add_test(tcase, test_arena_disabled);
+  suite_add_tcase(suite, tcase);
+
+  /* shortcuts */
+  tcase = tcase_create("shortcuts");
+  tcase_add_checked_fixture(tcase, setup, NULL);
+  tcase_add_test(tcase, test_shortcut_transaction);
+  tcase_add_test(tcase, test_feedkeys);
+  tcase_add_test(tcase, test_count_aware);
+  tcase_add_test(tcase, test_macro_feedkeys);
+  tcase_add_test(tcase, test_inputbar_shortcut_find);
+  tcase_add_test(tcase, test_key_translation_cache);
+  tcase_add_test(tcase, test_map);
+  suite_add_tcase(suite, tcase);
+
+  /* mouse events */
+  tcase = tcase_create("mouse events");
+  tcase_add_checked_fixture(tcase, setup, NULL);
+  tcase_add_test(tcase, test_mouse_event_index);
+  tcase_add_test(tcase, test_mouse_smooth_scroll);
+  tcase_add_test(tcase, test_mouse_coalesce);
+  suite_add_tcase(suite, tcase);
+
+  /* commands */
+  tcase = tcase_create("commands");
+  tcase_add_checked_fixture(tcase, setup, NULL);
+  tcase_add_test(tcase, test_command_find);
+  tcase_add_test(tcase, test_special_command_table);
+  tcase_add_test(tcase, test_special_command_debounce);
+  suite_add_tcase(suite, tcase);
+
+  /* latency */
+  tcase = tcase_create("latency");
+  tcase_add_checked_fixture(tcase, setup, NULL);
+  tcase_add_test(tcase, test_latency_empty);
+  tcase_add_test(tcase, test_latency_histogram);
+  tcase_add_test(tcase, test_latency_feedkeys);
+  tcase_add_test(tcase, test_latency_special);
+  suite_add_tcase(suite, tcase);
+
+  /* profile */
+  tcase = tcase_create("profile");
+  tcase_add_checked_fixture(tcase, setup, NULL);
+  tcase_add_test(tcase, test_profile);
   suite_add_tcase(suite, tcase);
 
   return suite;
@@ -10,6 +10,7 @@
 #include <glib.h>
 #include <glib/gstdio.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <pwd.h>
 #include <errno.h>
 #include <unistd.h>
@@ -294,6 +295,29 @@ START_TEST(test_strings_replace_substrings_4) {
   g_free(result);
 } END_TEST
 
+static void
+cb_spawn_exit(girara_session_t* GIRARA_UNUSED(session), int GIRARA_UNUSED(pid),
+    int status, void* data)
+{
+  int* result = data;
+  *result = status;
+}
+
+START_TEST(test_spawn) {
+  char* argv[] = { "sh", "-c", "exit 3", NULL };
+  fail_unless(girara_spawn(NULL, NULL, GIRARA_SPAWN_DEFAULT, NULL, NULL, NULL) == false);
+
+  int status = -1;
+  int pid = 0;
+  fail_unless(girara_spawn(NULL, argv, GIRARA_SPAWN_DEFAULT, cb_spawn_exit, &status, &pid) == true);
+  fail_unless(pid > 0);
+
+  while (status == -1) {
+    g_main_context_iteration(NULL, TRUE);
+  }
+  fail_unless(WIFEXITED(status) && WEXITSTATUS(status) == 3);
+} END_TEST
+
 Suite* suite_utils()
 {
   TCase* tcase = NULL;
@@ -345,6 +369,11 @@ Suite* suite_utils()
   tcase_add_test(tcase, test_strings_replace_substrings_3);
   suite_add_tcase(suite, tcase);
 
+  /* spawn */
+  tcase = tcase_create("spawn");
+  tcase_add_test(tcase, test_spawn);
+  suite_add_tcase(suite, tcase);
+
 
   return suite;
 }
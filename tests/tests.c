@@ -10,6 +10,7 @@ Suite* suite_settings();
 Suite* suite_session();
 Suite* suite_config();
 Suite* suite_template();
+Suite* suite_input_history();
 
 void setup(void)
 {
@@ -64,6 +65,12 @@ int main()
   number_failed += srunner_ntests_failed(suite_runner);
   srunner_free(suite_runner);
 
+  /* test input history */
+  suite        = suite_input_history();
+  suite_runner = srunner_create(suite);
+  srunner_run_all(suite_runner, CK_NORMAL);
+  number_failed += srunner_ntests_failed(suite_runner);
+  srunner_free(suite_runner);
 
   return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,122 @@
+/* See LICENSE file for license and copyright information */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <glib.h>
+
+#include "internal.h"
+#include "utils.h"
+
+#define TRACE_ENVIRONMENT_VARIABLE "GIRARA_TRACE"
+
+static FILE* trace_file      = NULL;
+static GThread* trace_thread = NULL;
+static bool trace_events     = false;
+
+static void
+trace_close(void)
+{
+  /* the closing bracket is optional for the trace viewers, but keeps the file
+   * valid JSON */
+  fputs("\n]\n", trace_file);
+  fclose(trace_file);
+  trace_file = NULL;
+}
+
+static FILE*
+trace_get_file(void)
+{
+  static gsize initialized = 0;
+
+  if (g_once_init_enter(&initialized)) {
+    const char* path = g_getenv(TRACE_ENVIRONMENT_VARIABLE);
+    if (path != NULL && path[0] != '\0') {
+      /* spawned children must not inherit the trace file */
+      const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+      trace_file   = fd != -1 ? fdopen(fd, "w") : NULL;
+      if (trace_file == NULL) {
+        girara_warning("Failed to open trace file '%s'.", path);
+        if (fd != -1) {
+          close(fd);
+        }
+      } else {
+        /* the file is written without locking, so only the thread that
+         * started tracing records spans */
+        trace_thread = g_thread_self();
+        fputs("[", trace_file);
+        atexit(trace_close);
+      }
+    }
+    g_once_init_leave(&initialized, 1);
+  }
+
+  return trace_file;
+}
+
+static void
+trace_append_escaped(GString* event, const char* str)
+{
+  for (; *str != '\0'; str++) {
+    switch (*str) {
+      case '"':
+        g_string_append(event, "\\\"");
+        break;
+      case '\\':
+        g_string_append(event, "\\\\");
+        break;
+      default:
+        if ((unsigned char) *str < 0x20) {
+          g_string_append_printf(event, "\\u%04x", (unsigned int) *str);
+        } else {
+          g_string_append_c(event, *str);
+        }
+        break;
+    }
+  }
+}
+
+gint64
+girara_trace_begin(void)
+{
+  if (trace_get_file() == NULL || g_thread_self() != trace_thread) {
+    return 0;
+  }
+
+  return g_get_monotonic_time();
+}
+
+void
+girara_trace_end(const char* name, const char* detail, gint64 start)
+{
+  if (start == 0 || trace_file == NULL || g_thread_self() != trace_thread) {
+    return;
+  }
+
+  const gint64 end = g_get_monotonic_time();
+  const int pid    = getpid();
+
+  /* complete event of the trace event format */
+  GString* event = g_string_new(trace_events == true ? ",\n" : "\n");
+  g_string_append(event, "{\"name\":\"");
+  trace_append_escaped(event, name);
+  g_string_append_printf(event,
+      "\",\"cat\":\"girara\",\"ph\":\"X\",\"ts\":%" G_GINT64_FORMAT
+      ",\"dur\":%" G_GINT64_FORMAT ",\"pid\":%d,\"tid\":%d",
+      start, end - start, pid, pid);
+  if (detail != NULL) {
+    g_string_append(event, ",\"args\":{\"detail\":\"");
+    trace_append_escaped(event, detail);
+    g_string_append(event, "\"}");
+  }
+  g_string_append_c(event, '}');
+
+  fputs(event->str, trace_file);
+  fflush(trace_file);
+  trace_events = true;
+
+  g_string_free(event, TRUE);
+}
@@ -5,10 +5,13 @@
 
 #include "version.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 typedef struct girara_tree_node_s girara_tree_node_t;
 typedef struct girara_list_s girara_list_t;
 typedef struct girara_list_iterator_s girara_list_iterator_t;
+typedef struct girara_map_s girara_map_t;
+typedef struct girara_map_iterator_s girara_map_iterator_t;
 typedef struct girara_setting_s girara_setting_t;
 typedef struct girara_session_s girara_session_t;
 typedef struct girara_session_private_s girara_session_private_t;
@@ -133,6 +136,15 @@ typedef void (*girara_list_callback_t)(void* data, void* userdata);
  */
 typedef int (*girara_compare_function_t)(const void* data1, const void* data2);
 
+/** Function declaration of a function that populates the children of a lazy
+ * tree node.
+ *
+ * @param node the node whose children are requested.
+ * @param userdata data passed to girara_node_set_loader.
+ */
+typedef void (*girara_node_loader_function_t)(girara_tree_node_t* node,
+    void* userdata);
+
 /**
  * This structure defines the possible types that a setting value can have
  */
@@ -196,7 +208,8 @@ typedef enum girara_event_type_e
   GIRARA_EVENT_SCROLL_DOWN, /**< Scroll event */
   GIRARA_EVENT_SCROLL_LEFT, /**< Scroll event */
   GIRARA_EVENT_SCROLL_RIGHT, /**< Scroll event */
-  GIRARA_EVENT_OTHER /**< Unknown event */
+  GIRARA_EVENT_OTHER, /**< Unknown event */
+  GIRARA_EVENT_SCROLL_BIDIRECTIONAL /**< Smooth scroll event */
 } girara_event_type_t;
 
 /**
@@ -208,12 +221,109 @@ struct girara_event_s
 
   double x; /**< X coordinates where the event occured */
   double y; /**< Y coordinates where the event occured */
+  double dx; /**< Horizontal delta of a smooth scroll event */
+  double dy; /**< Vertical delta of a smooth scroll event */
 };
 
+/**
+ * Categories of the memory allocated for the registries of a session
+ */
+typedef enum girara_memory_category_e
+{
+  GIRARA_MEMORY_SHORTCUTS, /**< Shortcuts, inputbar shortcuts and mouse events */
+  GIRARA_MEMORY_COMMANDS, /**< Inputbar and special commands */
+  GIRARA_MEMORY_SETTINGS, /**< Settings */
+  GIRARA_MEMORY_CONFIG, /**< Config handles, shortcut and argument mappings */
+  GIRARA_MEMORY_MODES, /**< Mode identifiers */
+  GIRARA_MEMORY_CATEGORY_COUNT /**< Number of categories */
+} girara_memory_category_t;
+
+/**
+ * Memory statistics of a category
+ */
+typedef struct girara_memory_stats_s
+{
+  size_t objects; /**< Number of allocated objects */
+  size_t bytes; /**< Number of allocated bytes including strings */
+} girara_memory_stats_t;
+
+/**
+ * Kinds of input whose handling latency is measured
+ */
+typedef enum girara_latency_source_e
+{
+  GIRARA_LATENCY_KEY_PRESS, /**< Key presses in the view */
+  GIRARA_LATENCY_BUTTON_PRESS, /**< Button presses in the view */
+  GIRARA_LATENCY_BUTTON_RELEASE, /**< Button releases in the view */
+  GIRARA_LATENCY_MOTION, /**< Pointer motion in the view */
+  GIRARA_LATENCY_SCROLL, /**< Scrolling in the view */
+  GIRARA_LATENCY_INPUTBAR_ACTIVATE, /**< Commands run from the inputbar */
+  GIRARA_LATENCY_SOURCE_COUNT /**< Number of sources */
+} girara_latency_source_t;
+
+/**
+ * Latency statistics of an input source or a binding. All times are given in
+ * microseconds. Percentiles are approximated by the upper bound of their
+ * power of two bucket.
+ */
+typedef struct girara_latency_stats_s
+{
+  unsigned int count; /**< Number of handled events */
+  unsigned long delay_p50; /**< Median delay from the event to the handler */
+  unsigned long delay_p99; /**< 99th percentile of the delay */
+  unsigned long delay_max; /**< Maximal delay */
+  unsigned long duration_p50; /**< Median execution time of the handler */
+  unsigned long duration_p99; /**< 99th percentile of the execution time */
+  unsigned long duration_max; /**< Maximal execution time */
+} girara_latency_stats_t;
+
+/**
+ * Kinds of profiled handlers
+ */
+typedef enum girara_profile_kind_e
+{
+  GIRARA_PROFILE_SHORTCUT, /**< Shortcut functions, including mouse events */
+  GIRARA_PROFILE_COMMAND, /**< Inputbar commands and config handles */
+  GIRARA_PROFILE_SETTING /**< Setting callbacks */
+} girara_profile_kind_t;
+
+/**
+ * Invocations and CPU time of a handler
+ */
+typedef struct girara_profile_entry_s
+{
+  const char* name; /**< Mapping, command or setting name of the handler */
+  girara_profile_kind_t kind; /**< Kind of the handler */
+  unsigned long calls; /**< Number of invocations */
+  unsigned long long cpu_time; /**< CPU time spent in microseconds */
+} girara_profile_entry_t;
+
+/**
+ * Flags for spawning child processes
+ */
+typedef enum girara_spawn_flags_e
+{
+  GIRARA_SPAWN_DEFAULT = 0, /**< Inherit stdout and stderr */
+  GIRARA_SPAWN_CAPTURE_OUTPUT = 1 << 0 /**< Show stdout and stderr as notifications */
+} girara_spawn_flags_t;
+
+/**
+ * Function declaration for a function called when a spawned child exits
+ *
+ * @param session The used girara session or NULL
+ * @param pid The process id of the child
+ * @param status The wait status of the child
+ * @param data User data
+ */
+typedef void (*girara_child_exit_function_t)(girara_session_t* session,
+    int pid, int status, void* data);
+
 typedef struct girara_input_history_io_s GiraraInputHistoryIO;
 typedef struct girara_input_history_io_interface_s GiraraInputHistoryIOInterface;
 typedef struct girara_input_history_s GiraraInputHistory;
 typedef struct girara_input_history_class_s GiraraInputHistoryClass;
+typedef struct girara_input_history_file_s GiraraInputHistoryFile;
+typedef struct girara_input_history_file_class_s GiraraInputHistoryFileClass;
 
 typedef struct girara_template_s GiraraTemplate;
 typedef struct girara_template_class_s GiraraTemplateClass;
@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <unistd.h>
 
 #include "utils.h"
@@ -70,21 +71,8 @@ girara_xdg_open(const char* uri)
     return false;
   }
 
-  GString* command = g_string_new("xdg-open ");
-  char* tmp        = g_shell_quote(uri);
-
-  g_string_append(command, tmp);
-  g_free(tmp);
-
-  GError* error = NULL;
-  bool res = g_spawn_command_line_async(command->str, &error);
-  if (error != NULL) {
-    girara_warning("Failed to execute command: %s", error->message);
-    g_error_free(error);
-  }
-
-  g_string_free(command, TRUE);
-  return res;
+  char* argv[] = { "xdg-open", (char*) uri, NULL };
+  return girara_spawn(NULL, argv, GIRARA_SPAWN_DEFAULT, NULL, NULL, NULL);
 }
 
 char*
@@ -481,6 +469,24 @@ girara_replace_substring(const char* string, const char* old, const char* new)
   return ret;
 }
 
+static void
+exec_child_exit(girara_session_t* session, int pid, int status, void* GIRARA_UNUSED(data))
+{
+  if (session == NULL) {
+    return;
+  }
+
+  if (WIFEXITED(status) && WEXITSTATUS(status) != 0) {
+    girara_notify(session, GIRARA_ERROR, _("Command exited with status %d"),
+        WEXITSTATUS(status));
+  } else if (WIFSIGNALED(status)) {
+    girara_notify(session, GIRARA_ERROR, _("Command was terminated by signal %d"),
+        WTERMSIG(status));
+  }
+
+  girara_debug("child %d exited with status %d", pid, status);
+}
+
 bool
 girara_exec_with_argument_list(girara_session_t* session, girara_list_t* argument_list)
 {
@@ -490,36 +496,50 @@ girara_exec_with_argument_list(girara_session_t* session, girara_list_t* argumen
 
   char* cmd = NULL;
   girara_setting_get(session, "exec-command", &cmd);
-  if (cmd == NULL || strlen(cmd) == 0) {
+
+  /* exec-command may consist of several words, the arguments are passed as
+   * they are */
+  char** prefix = NULL;
+  if (cmd != NULL && strlen(cmd) != 0) {
+    GError* error = NULL;
+    if (g_shell_parse_argv(cmd, NULL, &prefix, &error) == FALSE) {
+      girara_warning("Failed to parse exec-command: %s", error->message);
+      girara_notify(session, GIRARA_ERROR, _("Failed to execute command: %s"), error->message);
+      g_error_free(error);
+      g_free(cmd);
+      return false;
+    }
+  } else {
     girara_debug("exec-command is empty, executing directly.");
-    g_free(cmd);
-    cmd = NULL;
   }
-
-  bool dont_append_first_space = cmd == NULL;
-  GString* command = g_string_new(cmd ? cmd : "");
   g_free(cmd);
 
+  GPtrArray* argv = g_ptr_array_new();
+  for (char** word = prefix; word != NULL && *word != NULL; word++) {
+    g_ptr_array_add(argv, *word);
+  }
   GIRARA_LIST_FOREACH(argument_list, char*, iter, value)
-    if (dont_append_first_space == false) {
-      g_string_append_c(command, ' ');
-    }
-    dont_append_first_space = false;
-    char* tmp = g_shell_quote(value);
-    g_string_append(command, tmp);
-    g_free(tmp);
+    g_ptr_array_add(argv, value);
   GIRARA_LIST_FOREACH_END(argument_list, char*, iter, value);
+  g_ptr_array_add(argv, NULL);
+
+  bool ret = false;
+  if (argv->len > 1) {
+    girara_info("executing: %s", (char*) g_ptr_array_index(argv, 0));
 
-  GError* error = NULL;
-  girara_info("executing: %s", command->str);
-  gboolean ret = g_spawn_command_line_async(command->str, &error);
-  if (error != NULL) {
-    girara_warning("Failed to execute command: %s", error->message);
-    girara_notify(session, GIRARA_ERROR, _("Failed to execute command: %s"), error->message);
-    g_error_free(error);
+    bool output = false;
+    girara_setting_get(session, "exec-output", &output);
+    if (output == true) {
+      ret = girara_spawn(session, (char**) argv->pdata,
+          GIRARA_SPAWN_CAPTURE_OUTPUT, exec_child_exit, NULL, NULL);
+    } else {
+      ret = girara_spawn(session, (char**) argv->pdata, GIRARA_SPAWN_DEFAULT,
+          NULL, NULL, NULL);
+    }
   }
 
-  g_string_free(command, TRUE);
+  g_ptr_array_free(argv, TRUE);
+  g_strfreev(prefix);
 
   return ret;
 }
@@ -184,4 +184,21 @@ char* girara_replace_substring(const char* string, const char* old, const char*
  */
 bool girara_exec_with_argument_list(girara_session_t* session, girara_list_t* argument_list);
 
+/**
+ * Spawns a child process without going through a shell. The child is reaped
+ * once it exits.
+ *
+ * @param session The used girara session or NULL. Errors and captured output
+ *   are only reported to a session.
+ * @param argv NULL terminated argument vector, argv[0] is searched in PATH
+ * @param flags Spawn flags
+ * @param callback Function called when the child exits or NULL
+ * @param data Data passed to the callback
+ * @param pid Set to the process id of the child if not NULL
+ * @return true if the child has been spawned
+ */
+bool girara_spawn(girara_session_t* session, char* const argv[],
+    girara_spawn_flags_t flags, girara_child_exit_function_t callback,
+    void* data, int* pid);
+
 #endif